@@ -0,0 +1,150 @@
+namespace vitro {
+
+/** Benchmark of painting a dashboard of 500 cards.
+
+    Every other card shows a background image, all the cards have
+    a rounded border. The cards' backgrounds are painted with the cached
+    geometry and prescaled images, and compared with the previous
+    implementation reproduced below, which rebuilt the rounded shapes
+    and rescaled the full resolution image on each paint. Both paint
+    the same laid out cards, one by one at their positions.
+*/
+class BackgroundBenchmark final : public Benchmark
+{
+public:
+
+    BackgroundBenchmark()
+        : Benchmark("Background painting")
+    {
+    }
+
+    void runTest() override
+    {
+        constexpr int numCards{ 500 };
+        constexpr int numPaints{ 10 };
+        constexpr int viewWidth{ 2000 };
+        constexpr int viewHeight{ 1800 };
+
+        Context context{};
+
+        // Cached image is used without decoding.
+        const auto image{ createImage(512, 512) };
+        context.getLoader().getImageCache().add("card.png", image);
+
+        context.getStylesheet().populateFromString(
+            "View { flex-direction: row; flex-wrap: wrap; }\n"
+            "Panel { width: 80; height: 60; margin-all: 4; border-radius: 6; border-width: 1;"
+            " border-color: #404040; background-color: #e0e0e0; }\n"
+            "Panel.photo { background-image: \"card.png\"; }\n");
+
+        juce::String xml{ "<View>" };
+
+        for (int i{ 0 }; i < numCards; ++i)
+            xml << (i % 2 == 0 ? "<Panel class=\"photo\"/>" : "<Panel/>");
+
+        xml << "</View>";
+
+        auto view{ std::dynamic_pointer_cast<View>(context.getElementsFactory().createElement(View::tag)) };
+        view->populateFromXmlString(xml);
+        view->setBounds(0, 0, viewWidth, viewHeight);
+
+        // The view gets laid out asynchronously from the message loop, so the layout is forced here.
+        view->updateLayout();
+        view->recalculateLayout((float)viewWidth, (float)viewHeight);
+
+        std::vector<Panel*> cards{};
+
+        for (auto* child : view->getChildren()) {
+            if (auto* card{ dynamic_cast<Panel*>(child) }) {
+                expectEquals(card->getWidth(), 80);
+                expectEquals(card->getHeight(), 60);
+                cards.push_back(card);
+            }
+        }
+
+        expectEquals((int)cards.size(), numCards);
+        expect(juce::Rectangle<int>(viewWidth, viewHeight).contains(cards.back()->getBoundsInParent()));
+
+        juce::Image canvas{ juce::Image::ARGB, viewWidth, viewHeight, true };
+
+        beginTest("Paint " + juce::String(numCards) + " cards " + juce::String(numPaints) + " times");
+
+        const auto paintCards = [&](auto&& paintCard) {
+            juce::Graphics g{ canvas };
+
+            for (size_t i{ 0 }; i < cards.size(); ++i) {
+                juce::Graphics::ScopedSaveState state(g);
+                g.setOrigin(cards[i]->getPosition());
+                paintCard(g, i);
+            }
+        };
+
+        const auto before{ measure([&] {
+            for (int paint{ 0 }; paint < numPaints; ++paint) {
+                paintCards([&](juce::Graphics& g, size_t i) {
+                    paintBackgroundBefore(g, cards[i]->getWidth(), cards[i]->getHeight(),
+                                          i % 2 == 0 ? image : juce::Image{});
+                });
+            }
+        }) };
+
+        // Panel::paint paints the background only, whose geometry is created by the first paint.
+        const auto paintBackground = [&](juce::Graphics& g, size_t i) { cards[i]->paint(g); };
+
+        paintCards(paintBackground);
+
+        const auto after{ measure([&] {
+            for (int paint{ 0 }; paint < numPaints; ++paint)
+                paintCards(paintBackground);
+        }) };
+
+        logComparison("paint", before, after);
+    }
+
+private:
+
+    static juce::Image createImage(int width, int height)
+    {
+        juce::Image image{ juce::Image::ARGB, width, height, true };
+        juce::Graphics g{ image };
+        g.setGradientFill(juce::ColourGradient(juce::Colours::orange, 0.0f, 0.0f,
+                                               juce::Colours::darkblue, (float)width, (float)height, false));
+        g.fillAll();
+
+        return image;
+    }
+
+    // ComponentElementWithBackground::paintBackground prior to the cached geometry,
+    // with the style properties of the benchmark cards.
+    static void paintBackgroundBefore(juce::Graphics& g, int width, int height, const juce::Image& backgroundImage)
+    {
+        const juce::Colour backgroundColour{ 0xffe0e0e0 };
+        const juce::Colour borderColour{ 0xff404040 };
+        constexpr float borderRadius{ 6.0f };
+        constexpr float borderWidth{ 1.0f };
+
+        if (backgroundImage.isValid()) {
+            juce::Graphics::ScopedSaveState state(g);
+
+            juce::Path path{};
+            path.addRoundedRectangle(0.0f, 0.0f, (float)width, (float)height, borderRadius);
+            g.reduceClipRegion(path);
+            g.drawImage(backgroundImage, 0, 0, width, height,
+                                         0, 0, backgroundImage.getWidth(), backgroundImage.getHeight());
+        } else {
+            g.setColour(backgroundColour);
+            g.fillRoundedRectangle(0.0f, 0.0f, (float)width, (float)height, borderRadius);
+        }
+
+        const float offset{ 0.5f * borderWidth };
+
+        g.setColour(borderColour);
+        g.drawRoundedRectangle(offset, offset,
+            float(width) - borderWidth, float(height) - borderWidth,
+            borderRadius, borderWidth);
+    }
+};
+
+static BackgroundBenchmark backgroundBenchmark{};
+
+} // namespace vitro
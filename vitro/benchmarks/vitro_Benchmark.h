@@ -0,0 +1,53 @@
+namespace vitro {
+
+/** Base class for the performance benchmarks.
+
+    Benchmarks are unit tests of the "vitro-benchmarks" category, which log
+    the timings of the measured code paths. Each benchmark compares the current
+    implementation against the previous one where the latter can still be
+    reproduced. The benchmarks are compiled with VITRO_ENABLE_BENCHMARKS enabled,
+    and must be run on the message thread:
+
+    @code
+    juce::UnitTestRunner runner{};
+    runner.runTestsInCategory(vitro::Benchmark::category);
+    @endcode
+*/
+class Benchmark : public juce::UnitTest
+{
+public:
+
+    constexpr static const char* category = "vitro-benchmarks";
+
+    explicit Benchmark(const juce::String& name)
+        : juce::UnitTest(name, category)
+    {
+    }
+
+protected:
+
+    /** Returns the best time in milliseconds out of several runs of the function. */
+    template<typename Function>
+    static double measure(Function&& function, int numRuns = 5)
+    {
+        double best{ std::numeric_limits<double>::max() };
+
+        for (int i{ 0 }; i < numRuns; ++i) {
+            const auto start{ juce::Time::getMillisecondCounterHiRes() };
+            function();
+            best = juce::jmin(best, juce::Time::getMillisecondCounterHiRes() - start);
+        }
+
+        return best;
+    }
+
+    /** Log the timings of the previous and the current implementations. */
+    void logComparison(const juce::String& what, double beforeMs, double afterMs)
+    {
+        logMessage(what + ": " + juce::String(beforeMs, 2) + " ms before, "
+                   + juce::String(afterMs, 2) + " ms after ("
+                   + juce::String(beforeMs / juce::jmax(afterMs, 1.0e-6), 2) + "x)");
+    }
+};
+
+} // namespace vitro
@@ -0,0 +1,83 @@
+namespace vitro {
+
+/** Benchmark of loading the UI with and without a prepared context.
+
+    The view container loads the same view, style and script from
+    a temporary directory, either creating a new context on demand
+    (as before the context pool), or taking a context prepared by the pool.
+*/
+class ContextPoolBenchmark final : public Benchmark
+{
+public:
+
+    ContextPoolBenchmark()
+        : Benchmark("Context pool")
+    {
+    }
+
+    void runTest() override
+    {
+        constexpr int numRuns{ 5 };
+        constexpr int numElements{ 100 };
+
+        auto dir{ juce::File::getSpecialLocation(juce::File::tempDirectory).getNonexistentChildFile("vitro-benchmark", {}, false) };
+        dir.createDirectory();
+
+        juce::String xml{ "<View>" };
+
+        for (int i{ 0 }; i < numElements; ++i)
+            xml << "<Panel><Label text=\"Label " << i << "\"/></Panel>";
+
+        xml << "</View>";
+
+        dir.getChildFile("view.xml").replaceWithText(xml);
+        dir.getChildFile("style.css").replaceWithText("View { flex-direction: column; }\nPanel { height: 20; }\n");
+        dir.getChildFile("script.js").replaceWithText("var counter = 0;\nfunction increment() { ++counter; }\n");
+
+        auto* pool{ ContextPool::getInstance() };
+        const auto numPreparedContexts{ pool->getNumPreparedContexts() };
+
+        // No context is being prepared while the container is created.
+        pool->setNumPreparedContexts(0);
+
+        ViewContainer container{};
+        container.setLocalDirectory(dir);
+        container.setSize(800, 600);
+
+        auto load = [&] { container.loadFromResource("view.xml", "style.css", "script.js"); };
+
+        // Resources get cached by the OS on the first load.
+        load();
+
+        beginTest("Load the UI " + juce::String(numRuns) + " times");
+
+        const auto numMisses{ pool->getNumMisses() };
+        const auto before{ measure(load, numRuns) };
+        expectEquals(pool->getNumMisses() - numMisses, numRuns);
+
+        pool->setNumPreparedContexts(1);
+
+        const auto numHits{ pool->getNumHits() };
+        double after{ std::numeric_limits<double>::max() };
+
+        for (int i{ 0 }; i < numRuns; ++i) {
+            // The context must be ready before the load starts.
+            for (int attempts{ 0 }; attempts < 10000 && pool->getNumAvailableContexts() == 0; ++attempts)
+                juce::Thread::sleep(1);
+
+            after = juce::jmin(after, measure(load, 1));
+        }
+
+        expectEquals(pool->getNumHits() - numHits, numRuns);
+
+        logComparison("loadFromResource", before, after);
+        logMessage("Average context creation time: " + juce::String(pool->getAverageCreationTime(), 2) + " ms");
+
+        pool->setNumPreparedContexts(numPreparedContexts);
+        dir.deleteRecursively();
+    }
+};
+
+static ContextPoolBenchmark contextPoolBenchmark{};
+
+} // namespace vitro
@@ -0,0 +1,124 @@
+namespace vitro {
+
+/** Benchmark of the elements resolution from their JavaScript objects.
+
+    The previous implementation accepted any opaque pointer as the element
+    reference and performed a dynamic cast on every call. This compares it
+    with the registered class types lookup, both natively and via 1M calls
+    of getAttribute() from the script.
+*/
+class JSObjectBenchmark final : public Benchmark
+{
+public:
+
+    JSObjectBenchmark()
+        : Benchmark("JS element resolution")
+    {
+    }
+
+    void runTest() override
+    {
+        constexpr int numCalls{ 1000000 };
+
+        Context context{};
+
+        auto view{ std::dynamic_pointer_cast<View>(context.getElementsFactory().createElement(View::tag)) };
+        view->exposeToJS();
+        view->populateFromXmlString("<View><Panel id=\"panel\" value=\"42\"/></View>");
+
+        auto panel{ view->getElementById("panel") };
+        expect(panel != nullptr);
+
+        auto* jsCtx{ context.getJSContext() };
+        auto obj{ panel->duplicateJSValue() };
+
+        beginTest("getJSNativeObject<Panel>");
+        {
+            int numResolved{};
+
+            const auto before{ measure([&] {
+                for (int i{ 0 }; i < numCalls; ++i)
+                    numResolved += getJSNativeObjectBefore<Panel>(obj) != nullptr ? 1 : 0;
+            }) };
+
+            const auto after{ measure([&] {
+                for (int i{ 0 }; i < numCalls; ++i)
+                    numResolved -= Context::getJSNativeObject<Panel>(obj) != nullptr ? 1 : 0;
+            }) };
+
+            expectEquals(numResolved, 0);
+            logComparison(juce::String(numCalls) + " calls", before, after);
+        }
+
+        beginTest("getAttribute");
+        {
+            // The previous resolution is exposed to the script as a sibling method.
+            auto proto{ JS_GetPrototype(jsCtx, obj) };
+            JS_SetPropertyStr(jsCtx, proto, "getAttributeBefore", JS_NewCFunction(jsCtx, js_getAttributeBefore, "getAttributeBefore", 1));
+
+            JS_FreeValue(jsCtx, context.eval(
+                "const benchmarkPanel = view.getElementById('panel');\n"
+                "function benchmarkBefore(n) { let r = 0; for (let i = 0; i < n; ++i) if (benchmarkPanel.getAttributeBefore('value') == 42) ++r; return r; }\n"
+                "function benchmarkAfter(n) { let r = 0; for (let i = 0; i < n; ++i) if (benchmarkPanel.getAttribute('value') == 42) ++r; return r; }\n"));
+
+            int numMatched{};
+
+            auto run = [&](const juce::String& function) {
+                auto res{ context.eval(function + "(" + juce::String(numCalls) + ")") };
+                JS_ToInt32(jsCtx, &numMatched, res);
+                JS_FreeValue(jsCtx, res);
+            };
+
+            const auto before{ measure([&] { run("benchmarkBefore"); }) };
+            expectEquals(numMatched, numCalls);
+
+            const auto after{ measure([&] { run("benchmarkAfter"); }) };
+            expectEquals(numMatched, numCalls);
+
+            logComparison(juce::String(numCalls) + " calls", before, after);
+
+            const auto atom{ JS_NewAtom(jsCtx, "getAttributeBefore") };
+            JS_DeleteProperty(jsCtx, proto, atom, 0);
+            JS_FreeAtom(jsCtx, atom);
+            JS_FreeValue(jsCtx, proto);
+        }
+
+        JS_FreeValue(jsCtx, obj);
+    }
+
+private:
+
+    // Element resolution prior to the class types registry.
+    template<class T>
+    static std::shared_ptr<T> getJSNativeObjectBefore(JSValue obj)
+    {
+        void* opaque{ nullptr };
+        JS_GetClassID(obj, &opaque);
+
+        if (auto* ref{ static_cast<Element::JSObjectRef*>(opaque) }) {
+            if (auto elementPtr{ ref->element.lock() })
+                return std::dynamic_pointer_cast<T>(elementPtr);
+        }
+
+        return nullptr;
+    }
+
+    // Element::js_getAttribute with the previous resolution.
+    static JSValue js_getAttributeBefore(JSContext* ctx, JSValueConst self, int argc, JSValueConst* arg)
+    {
+        if (argc != 1)
+            return JS_ThrowSyntaxError(ctx, "getAttribute expects a single argument - attribute's name");
+
+        if (auto element{ getJSNativeObjectBefore<Element>(self) }) {
+            auto* context{ Context::getContextFromJSContext(ctx) };
+            const auto attrName{ context->getAtomCache().getIdentifier(ctx, arg[0]) };
+            return js::varToJSValue(ctx, element->getAttribute(attrName));
+        }
+
+        return JS_UNDEFINED;
+    }
+};
+
+static JSObjectBenchmark jsObjectBenchmark{};
+
+} // namespace vitro
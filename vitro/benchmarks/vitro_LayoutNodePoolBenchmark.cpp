@@ -0,0 +1,126 @@
+namespace vitro {
+
+/** Benchmark of a large tree layout with the nodes allocated from the pool.
+
+    The tree is built, laid out several times, and released, with the nodes
+    allocated either individually by Yoga (the previous implementation)
+    or by the LayoutNodePool. Each node is accompanied by an element-sized
+    heap allocation to reproduce the heap fragmentation of a real UI load.
+*/
+class LayoutNodePoolBenchmark final : public Benchmark
+{
+public:
+
+    LayoutNodePoolBenchmark()
+        : Benchmark("Layout node pool")
+    {
+    }
+
+    void runTest() override
+    {
+        constexpr int numRows{ 100 };
+        constexpr int numColumns{ 100 };
+        constexpr int numLayouts{ 20 };
+
+        LayoutNodePool pool{};
+
+        const auto allocateYoga = []() -> YGNodeRef { return YGNodeNew(); };
+        const auto releaseYoga = [](YGNodeRef node) { YGNodeFree(node); };
+        const auto allocatePool = [&pool]() -> YGNodeRef { return pool.allocate(); };
+        const auto releasePool = [&pool](YGNodeRef node) { pool.release(node); };
+
+        Tree tree{};
+
+        beginTest("Create and release " + juce::String((numRows + 1) * numColumns + 1) + " nodes");
+        {
+            const auto before{ measure([&] {
+                tree.create(numRows, numColumns, allocateYoga);
+                tree.release(releaseYoga);
+            }) };
+
+            const auto after{ measure([&] {
+                tree.create(numRows, numColumns, allocatePool);
+                tree.release(releasePool);
+            }) };
+
+            expectEquals((int)pool.getNumAllocatedNodes(), 0);
+            logComparison("create and release", before, after);
+        }
+
+        beginTest("Compute " + juce::String(numLayouts) + " layouts");
+        {
+            tree.create(numRows, numColumns, allocateYoga);
+            const auto before{ measure([&] { tree.layout(numLayouts); }) };
+            tree.release(releaseYoga);
+
+            tree.create(numRows, numColumns, allocatePool);
+            const auto after{ measure([&] { tree.layout(numLayouts); }) };
+            tree.release(releasePool);
+
+            logComparison("layout", before, after);
+        }
+    }
+
+private:
+
+    struct Tree final
+    {
+        // Nodes in the tree order, the root first.
+        std::vector<YGNodeRef> nodes{};
+
+        // Allocations standing for the elements owning the nodes.
+        std::vector<std::unique_ptr<std::byte[]>> elements{};
+
+        template<typename Allocate>
+        YGNodeRef createNode(Allocate& allocate)
+        {
+            elements.push_back(std::make_unique<std::byte[]>(512));
+            nodes.push_back(allocate());
+            return nodes.back();
+        }
+
+        template<typename Allocate>
+        void create(int numRows, int numColumns, Allocate&& allocate)
+        {
+            auto* root{ createNode(allocate) };
+            YGNodeStyleSetFlexDirection(root, YGFlexDirectionColumn);
+
+            for (int row{ 0 }; row < numRows; ++row) {
+                auto* rowNode{ createNode(allocate) };
+                YGNodeStyleSetFlexDirection(rowNode, YGFlexDirectionRow);
+                YGNodeStyleSetFlexWrap(rowNode, YGWrapWrap);
+                YGNodeInsertChild(root, rowNode, (uint32_t)row);
+
+                for (int column{ 0 }; column < numColumns; ++column) {
+                    auto* cell{ createNode(allocate) };
+                    YGNodeStyleSetFlexGrow(cell, 1.0f);
+                    YGNodeStyleSetMargin(cell, YGEdgeAll, 2.0f);
+                    YGNodeStyleSetHeight(cell, 20.0f);
+                    YGNodeInsertChild(rowNode, cell, (uint32_t)column);
+                }
+            }
+        }
+
+        void layout(int numLayouts)
+        {
+            // Alternating width forces the entire tree to be laid out again.
+            for (int i{ 0 }; i < numLayouts; ++i)
+                YGNodeCalculateLayout(nodes.front(), 1000.0f + (float)(i % 2), YGUndefined, YGDirectionLTR);
+        }
+
+        template<typename Release>
+        void release(Release&& releaseNode)
+        {
+            // Parents are released first, which detaches their children.
+            for (auto* node : nodes)
+                releaseNode(node);
+
+            nodes.clear();
+            elements.clear();
+        }
+    };
+};
+
+static LayoutNodePoolBenchmark layoutNodePoolBenchmark{};
+
+} // namespace vitro
@@ -0,0 +1,103 @@
+namespace vitro {
+
+namespace {
+    // Limits the memory used by arbitrary object keys,
+    // the least recently used names get evicted beyond that.
+    constexpr size_t kMaxCachedNames = 4096;
+}
+
+AtomCache::AtomCache(JSRuntime* rt)
+    : runtime{ rt },
+      identifiers{ kMaxCachedNames }
+{
+    jassert(runtime != nullptr);
+
+    identifiers.onRemove = [this](const JSAtom& atom, juce::Identifier& id) {
+        if (const auto it{ atoms.find(id.getCharPointer().getAddress()) }; it != atoms.end() && it->second == atom)
+            atoms.erase(it);
+
+        JS_FreeAtomRT(runtime, atom);
+    };
+}
+
+AtomCache::~AtomCache()
+{
+    clear();
+}
+
+juce::Identifier AtomCache::getIdentifier(JSContext* ctx, JSAtom atom)
+{
+    if (const auto* id{ identifiers.find(atom) })
+        return *id;
+
+    const auto* str{ JS_AtomToCString(ctx, atom) };
+
+    if (str == nullptr)
+        return {};
+
+    const auto name{ String::fromUTF8(str) };
+    JS_FreeCString(ctx, str);
+
+    if (name.isEmpty())
+        return {};
+
+    const juce::Identifier id{ name };
+    add(JS_DupAtom(ctx, atom), id);
+
+    return id;
+}
+
+juce::Identifier AtomCache::getIdentifier(JSContext* ctx, JSValueConst value)
+{
+    const auto atom{ JS_ValueToAtom(ctx, value) };
+
+    if (atom == JS_ATOM_NULL)
+        return {};
+
+    const auto id{ getIdentifier(ctx, atom) };
+    JS_FreeAtom(ctx, atom);
+
+    return id;
+}
+
+JSAtom AtomCache::getAtom(JSContext* ctx, const juce::Identifier& id)
+{
+    if (const auto it{ atoms.find(id.getCharPointer().getAddress()) }; it != atoms.end()) {
+        const auto atom{ it->second };
+
+        // Mark the name as recently used.
+        identifiers.find(atom);
+        return atom;
+    }
+
+    const auto& name{ id.toString() };
+    const auto atom{ JS_NewAtomLen(ctx, name.toRawUTF8(), name.getNumBytesAsUTF8()) };
+
+    if (atom == JS_ATOM_NULL)
+        return atom;
+
+    if (identifiers.find(atom) != nullptr) {
+        // Same name, but from a different identifiers pool entry.
+        // The atom remains retained by the cache.
+        JS_FreeAtom(ctx, atom);
+        return atom;
+    }
+
+    add(atom, id);
+
+    return atom;
+}
+
+void AtomCache::clear()
+{
+    identifiers.clear();
+    atoms.clear();
+}
+
+void AtomCache::add(JSAtom atom, const juce::Identifier& id)
+{
+    identifiers.add(atom, id);
+    atoms.emplace(id.getCharPointer().getAddress(), atom);
+}
+
+} // namespace vitro
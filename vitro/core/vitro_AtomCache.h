@@ -0,0 +1,60 @@
+namespace vitro {
+
+/** Cache of the JavaScript atoms and identifiers.
+
+    Attribute and property names cross the JavaScript bridge as
+    QuickJS atoms on one side and juce::Identifier on the other.
+    Converting between the two requires a string copy and a lookup
+    in the global identifiers pool. This cache maps the atoms to the
+    identifiers and back, so that converting an already seen name
+    is a single hash lookup.
+
+    Atoms belong to the JavaScript runtime, so the cache stays valid
+    when the JavaScript context gets reset.
+
+    @see Context::getAtomCache
+*/
+class AtomCache final
+{
+public:
+
+    AtomCache(JSRuntime* rt);
+    ~AtomCache();
+
+    /** Returns the identifier of an atom. */
+    juce::Identifier getIdentifier(JSContext* ctx, JSAtom atom);
+
+    /** Returns the identifier of a JavaScript value converted to a string. */
+    juce::Identifier getIdentifier(JSContext* ctx, JSValueConst value);
+
+    /** Returns the atom of an identifier.
+
+        The returned atom is owned by the cache, and it remains
+        valid until the next cache lookup.
+    */
+    JSAtom getAtom(JSContext* ctx, const juce::Identifier& id);
+
+    /** Returns the number of the cached names. */
+    size_t getNumCachedNames() const { return identifiers.size(); }
+
+    /** Release all the cached atoms. */
+    void clear();
+
+private:
+
+    void add(JSAtom atom, const juce::Identifier& id);
+
+    JSRuntime* runtime;
+
+    // Identifiers of the atoms. The atoms are retained by the cache
+    // and released once evicted.
+    LRUCache<JSAtom, juce::Identifier> identifiers;
+
+    // Atoms indexed by the pooled identifier strings. The strings
+    // are kept alive by the identifiers stored in the map above.
+    std::unordered_map<const char*, JSAtom> atoms{};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AtomCache)
+};
+
+} // namespace vitro
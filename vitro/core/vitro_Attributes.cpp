@@ -18,6 +18,10 @@ const Identifier visible    ("visible");
 const Identifier readonly   ("readonly");
 const Identifier draggable  ("draggable");
 const Identifier acceptdrop ("acceptdrop");
+const Identifier asynclayout ("asynclayout");
+const Identifier resizemode ("resizemode");
+const Identifier paintflashing ("paintflashing");
+const Identifier rasterize  ("rasterize");
 
 const Identifier x          ("x");
 const Identifier y          ("y");
@@ -36,6 +40,10 @@ const Identifier max        ("max");
 const Identifier step       ("step");
 const Identifier selectedid ("selectedid");
 const Identifier syntax     ("syntax");
+const Identifier count      ("count");
+const Identifier items      ("items");
+const Identifier index      ("index");
+const Identifier overscan   ("overscan");
 
 const Identifier hover      ("hover");
 const Identifier active     ("active");
@@ -50,6 +58,7 @@ const Identifier onmove     ("onmove");
 const Identifier onresize   ("onresize");
 const Identifier ondrop     ("ondrop");
 const Identifier onacceptdrop ("onacceptdrop");
+const Identifier onbindrow  ("onbindrow");
 
 const Identifier onmouseenter ("onmouseenter");
 const Identifier onmouseexit  ("onmouseexit");
@@ -82,6 +91,8 @@ const Identifier shadow_radius                ("shadow-radius");
 const Identifier shadow_offset_x              ("shadow-offset-x");
 const Identifier shadow_offset_y              ("shadow-offset-y");
 
+const Identifier layer                        ("layer");
+
 const Identifier text_align                   ("text-align");
 const Identifier text_color                   ("text-color");
 const Identifier text_color_on                ("text-color-on");
@@ -137,6 +148,7 @@ const Identifier text_box_height              ("text-box-height");
 const Identifier vertical_scrollbar           ("vertical-scrollbar");
 const Identifier horizontal_scrollbar         ("horizontal-scrollbar");
 const Identifier scrollbar_thickness          ("scrollbar-thickness");
+const Identifier row_height                   ("row-height");
 
 const Identifier orientation                  ("orientation");
 
@@ -153,6 +165,7 @@ bool isVolatile(const Identifier& attr)
         || attr == onenter
         || attr == onmove
         || attr == onresize
+        || attr == onbindrow
         || attr == onmouseenter
         || attr == onmouseexit
         || attr == onmousemove
@@ -0,0 +1,239 @@
+namespace vitro {
+
+namespace {
+
+#ifdef QUICKJS_VERSION
+    const char* const kEngineName{ "quickjs-" QUICKJS_VERSION };
+#else
+    // The engine bundled with JUCE has no version of its own.
+    const char* const kEngineName{ "quickjs-choc-juce-" JUCE_STRINGIFY(JUCE_MAJOR_VERSION) "."
+                                   JUCE_STRINGIFY(JUCE_MINOR_VERSION) "." JUCE_STRINGIFY(JUCE_BUILDNUMBER) };
+#endif
+
+    // The bytecode of this script identifies the engine build, since it starts
+    // with the bytecode format version (BC_VERSION), and its opcodes and
+    // function layout change along with the engine.
+    const char* const kEngineProbeScript{
+        "function f(a, ...b) { let { c = 1 } = a || {}; const r = [];"
+        " for (const x of b) r.push(`${x}${c}`); class C extends Array { m() { return super.length; } }"
+        " return [r, new C(), /r+/g, typeof a, a instanceof C, delete a.c, () => this, { ...a }]; }"
+        " async function* g(x) { try { yield await f(x); } catch { throw new Error(); } finally { x = null; } }"
+    };
+
+    // The least recently used bytecode gets evicted beyond this size.
+    constexpr size_t kMaxMemoryStorageSize = 32 * 1024 * 1024;
+
+    const char* const kBytecodeFileExtension{ ".qjsbc" };
+
+    // Bytecode file layout:
+    //   magic           4 bytes
+    //   key             64 bytes, the hexadecimal SHA-256 of the engine version,
+    //                   evaluation type, file name and source
+    //   bytecode digest 32 bytes, SHA-256 of the bytecode
+    //   bytecode size   8 bytes, little endian
+    //   bytecode
+    const char kBytecodeFileMagic[]{ 'V', 'B', 'C', '1' };
+    constexpr size_t kKeySize = 64;
+    constexpr size_t kDigestSize = 32;
+    constexpr size_t kBytecodeFileHeaderSize = sizeof(kBytecodeFileMagic) + kKeySize + kDigestSize + sizeof(juce::int64);
+
+} // namespace
+
+/** Bytecode shared by all the contexts of the process. */
+struct BytecodeCache::MemoryStorage final
+{
+    CriticalSection lock{};
+    LRUCache<String, MemoryBlock, StringHash> entries{ kMaxMemoryStorageSize };
+};
+
+//==============================================================================
+
+BytecodeCache::BytecodeCache() = default;
+
+BytecodeCache::~BytecodeCache() = default;
+
+void BytecodeCache::setDirectory(const juce::File& dir)
+{
+    directory = dir;
+
+    if (directory != File() && !directory.isDirectory()) {
+        if (const auto res{ directory.createDirectory() }; res.failed()) {
+            DBG("Unable to create bytecode cache directory " << directory.getFullPathName() << ": " << res.getErrorMessage());
+            directory = File();
+        }
+    }
+}
+
+JSValue BytecodeCache::compile(JSContext* ctx, const juce::String& source, const juce::String& fileName, int evalFlags)
+{
+    const auto engineVersion{ getEngineVersion(ctx) };
+    const auto key{ getKey(engineVersion, source, fileName, evalFlags) };
+
+    // Bytecode of an unidentified engine build must not outlive the process.
+    const auto dir{ engineVersion.isNotEmpty() ? directory : File() };
+
+    if (const auto bytecode{ read(key, dir) }; !bytecode.isEmpty()) {
+        auto func{ JS_ReadObject(ctx, (const uint8_t*)bytecode.getData(), bytecode.getSize(), JS_READ_OBJ_BYTECODE) };
+
+        if (!JS_IsException(func)) {
+            ++numHits;
+
+            // Resolving fails on the import errors (e.g. a missing dependency),
+            // which must be reported, whereas the cached bytecode is valid.
+            if (JS_ResolveModule(ctx, func) < 0) {
+                JS_FreeValue(ctx, func);
+                return JS_EXCEPTION;
+            }
+
+            return func;
+        }
+
+        // Incompatible bytecode, fall back to the source.
+        DBG("Unable to load cached bytecode of " << fileName);
+        JS_FreeValue(ctx, JS_GetException(ctx));
+        remove(key, dir);
+    }
+
+    ++numMisses;
+
+    const auto utf8{ source.toUTF8() };
+    auto func{ JS_Eval(ctx, utf8, utf8.sizeInBytes() - 1, fileName.toRawUTF8(), evalFlags | JS_EVAL_FLAG_COMPILE_ONLY) };
+
+    if (JS_IsException(func))
+        return func;
+
+    size_t size{};
+
+    if (auto* data{ JS_WriteObject(ctx, &size, func, JS_WRITE_OBJ_BYTECODE) }) {
+        write(key, dir, MemoryBlock(data, size));
+        js_free(ctx, data);
+    }
+
+    return func;
+}
+
+juce::String BytecodeCache::getEngineVersion(JSContext* ctx)
+{
+    // The engine gets identified once per process.
+    static const String version{ [ctx] {
+        auto func{ JS_Eval(ctx, kEngineProbeScript, std::strlen(kEngineProbeScript), "<engine>",
+                           JS_EVAL_TYPE_GLOBAL | JS_EVAL_FLAG_COMPILE_ONLY) };
+
+        if (JS_IsException(func)) {
+            DBG("Unable to identify the JavaScript engine, the bytecode disk cache is disabled");
+            JS_FreeValue(ctx, JS_GetException(ctx));
+            return String();
+        }
+
+        size_t size{};
+        auto* data{ JS_WriteObject(ctx, &size, func, JS_WRITE_OBJ_BYTECODE) };
+        JS_FreeValue(ctx, func);
+
+        if (data == nullptr) {
+            JS_FreeValue(ctx, JS_GetException(ctx));
+            return String();
+        }
+
+        const SHA256 digest(data, size);
+        js_free(ctx, data);
+
+        return String(kEngineName) + ";" + digest.toHexString();
+    }() };
+
+    return version;
+}
+
+juce::String BytecodeCache::getKey(const juce::String& engineVersion, const juce::String& source,
+                                   const juce::String& fileName, int evalFlags)
+{
+    MemoryOutputStream id{};
+    id << engineVersion << ";" << String(evalFlags) << ";" << fileName << "\n" << source;
+
+    return SHA256(id.getData(), id.getDataSize()).toHexString();
+}
+
+juce::MemoryBlock BytecodeCache::read(const juce::String& key, const juce::File& dir)
+{
+    {
+        const ScopedLock scopedLock(memoryStorage->lock);
+
+        if (const auto* bytecode{ memoryStorage->entries.find(key) })
+            return *bytecode;
+    }
+
+    if (dir == File())
+        return {};
+
+    const auto file{ dir.getChildFile(key + kBytecodeFileExtension) };
+    MemoryBlock data{};
+
+    if (!file.existsAsFile() || !file.loadFileAsData(data))
+        return {};
+
+    // JS_ReadObject does not validate the bytecode, so a file written for
+    // another source or engine, or corrupted, must not reach it.
+    const auto* bytes{ static_cast<const char*>(data.getData()) };
+    const auto size{ data.getSize() };
+
+    bool valid{ size >= kBytecodeFileHeaderSize
+                && std::memcmp(bytes, kBytecodeFileMagic, sizeof(kBytecodeFileMagic)) == 0
+                && std::memcmp(bytes + sizeof(kBytecodeFileMagic), key.toRawUTF8(), kKeySize) == 0 };
+
+    if (valid) {
+        const auto* digest{ bytes + sizeof(kBytecodeFileMagic) + kKeySize };
+
+        valid = ByteOrder::littleEndianInt64(digest + kDigestSize) == (juce::uint64)(size - kBytecodeFileHeaderSize)
+             && SHA256(bytes + kBytecodeFileHeaderSize, size - kBytecodeFileHeaderSize).getRawData() == MemoryBlock(digest, kDigestSize);
+    }
+
+    if (!valid) {
+        DBG("Invalid bytecode cache file " << file.getFullPathName());
+        file.deleteFile();
+        return {};
+    }
+
+    MemoryBlock bytecode(bytes + kBytecodeFileHeaderSize, size - kBytecodeFileHeaderSize);
+
+    const ScopedLock scopedLock(memoryStorage->lock);
+    memoryStorage->entries.add(key, bytecode, bytecode.getSize());
+
+    return bytecode;
+}
+
+void BytecodeCache::write(const juce::String& key, const juce::File& dir, const juce::MemoryBlock& bytecode)
+{
+    {
+        const ScopedLock scopedLock(memoryStorage->lock);
+        memoryStorage->entries.add(key, bytecode, bytecode.getSize());
+    }
+
+    if (dir == File())
+        return;
+
+    jassert(key.getNumBytesAsUTF8() == kKeySize);
+
+    MemoryOutputStream data(kBytecodeFileHeaderSize + bytecode.getSize());
+    data.write(kBytecodeFileMagic, sizeof(kBytecodeFileMagic));
+    data.write(key.toRawUTF8(), kKeySize);
+    data << SHA256(bytecode).getRawData();
+    data.writeInt64((juce::int64)bytecode.getSize());
+    data << bytecode;
+
+    const auto file{ dir.getChildFile(key + kBytecodeFileExtension) };
+
+    if (!file.replaceWithData(data.getData(), data.getDataSize()))
+        DBG("Unable to write bytecode cache file " << file.getFullPathName());
+}
+
+void BytecodeCache::remove(const juce::String& key, const juce::File& dir)
+{
+    {
+        const ScopedLock scopedLock(memoryStorage->lock);
+        memoryStorage->entries.remove(key);
+    }
+
+    if (dir != File())
+        dir.getChildFile(key + kBytecodeFileExtension).deleteFile();
+}
+
+} // namespace vitro
@@ -0,0 +1,78 @@
+namespace vitro {
+
+/** Cache of the compiled JavaScript bytecode.
+
+    Compiling a large script is expensive, so the scripts and modules
+    get compiled once, and the bytecode is then reused for the same source.
+    The bytecode is kept in memory, shared by all the contexts of the process,
+    and optionally stored on disk so that it survives the application restart.
+
+    The cached bytecode is identified by the SHA-256 digest of the script
+    source, its file name, the evaluation type and the JavaScript engine
+    version, which includes a fingerprint of the engine's bytecode format.
+    The files on disk store this digest along with the digest of the bytecode,
+    and are verified before the bytecode gets loaded. Should the cached
+    bytecode be invalid or fail to load, the script gets compiled from the source.
+
+    @see Context::getBytecodeCache
+*/
+class BytecodeCache final
+{
+public:
+
+    BytecodeCache();
+    ~BytecodeCache();
+
+    /** Assign a directory to store the compiled bytecode in.
+
+        The directory gets created if it does not exist.
+        Pass an empty file to disable the disk cache, which is the default.
+    */
+    void setDirectory(const juce::File& dir);
+
+    const juce::File& getDirectory() const { return directory; }
+
+    /** Compile the script or load it from the cache.
+
+        This returns a compiled, but not yet evaluated, function or module
+        ready to be passed to JS_EvalFunction, or an exception if the
+        script cannot be compiled, or if the imports of a cached module
+        cannot be resolved.
+
+        @param evalFlags    Either JS_EVAL_TYPE_GLOBAL or JS_EVAL_TYPE_MODULE.
+    */
+    JSValue compile(JSContext* ctx, const juce::String& source, const juce::String& fileName, int evalFlags);
+
+    /** Returns the number of scripts loaded from the cache. */
+    int getNumHits() const { return numHits; }
+
+    /** Returns the number of scripts compiled from the source. */
+    int getNumMisses() const { return numMisses; }
+
+private:
+
+    struct MemoryStorage;
+
+    // Returns the engine identification, or an empty string if unknown.
+    static juce::String getEngineVersion(JSContext* ctx);
+
+    static juce::String getKey(const juce::String& engineVersion, const juce::String& source,
+                               const juce::String& fileName, int evalFlags);
+
+    // Returns the cached bytecode, or an empty block if not cached.
+    // The files are looked up in the given directory, if any.
+    juce::MemoryBlock read(const juce::String& key, const juce::File& dir);
+    void write(const juce::String& key, const juce::File& dir, const juce::MemoryBlock& bytecode);
+    void remove(const juce::String& key, const juce::File& dir);
+
+    juce::SharedResourcePointer<MemoryStorage> memoryStorage;
+
+    juce::File directory{};
+
+    int numHits{};
+    int numMisses{};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(BytecodeCache)
+};
+
+} // namespace vitro
@@ -57,6 +57,8 @@ ComponentElement::ComponentElement(const Identifier& elementTag, Context& ctx)
     registerStyleProperty(attr::css::shadow_radius);
     registerStyleProperty(attr::css::shadow_offset_x);
     registerStyleProperty(attr::css::shadow_offset_y);
+    registerStyleProperty(attr::css::border_radius);
+    registerStyleProperty(attr::css::layer);
 }
 
 ComponentElement::Ptr ComponentElement::getParentComponentElement()
@@ -73,13 +75,18 @@ ComponentElement::Ptr ComponentElement::getParentComponentElement()
     return nullptr;
 }
 
-void ComponentElement::updateComponentBoundsToLayoutNode()
+bool ComponentElement::updateComponentBoundsToLayoutNode()
 {
     if (auto* component{ getComponent() }) {
         auto targetBounds{ getLayoutElementBounds().toNearestInt() };
 
-        component->setBounds(targetBounds);
+        if (component->getBounds() != targetBounds) {
+            component->setBounds(targetBounds);
+            return true;
+        }
     }
+
+    return false;
 }
 
 bool ComponentElement::isInterestedInDragSource(const SourceDetails& dragSourceDetails)
@@ -92,34 +99,25 @@ bool ComponentElement::isInterestedInDragSource(const SourceDetails& dragSourceD
     // @todo Invoke onacceprdrop script
     if (auto* comp{ dragSourceDetails.sourceComponent.get() }) {
         if (auto* element{ dynamic_cast<Element*>(comp) }) {
-            const auto val{ getAttribute(attr::onacceptdrop) };
+            // The result of a statements script is its completion value, as it has always been.
+            const auto func{ getAttributeFunction(attr::onacceptdrop, true) };
 
-            if (val.isVoid())
+            if (JS_IsUndefined(func))
                 return shouldAccept;
 
             JSValue dropJsValue{ element->duplicateJSValue() };
             auto* jsCtx{ context.getJSContext() };
 
-            if (val.isObject()) {
-                if (auto* func{ dynamic_cast<js::Function*>(val.getObject()) }) {
-                    auto ret{ JS_Call(jsCtx, func->getJSValue(), jsValue, 1, &dropJsValue) };
-                    shouldAccept = JS_VALUE_GET_BOOL(ret);
-                    JS_FreeValue(jsCtx, ret);
-                }
-            } else {
-                auto res{ context.evalThis(jsValue, val.toString()) };
-
-                if (JS_IsException(res)) {
-                    DBG("Exception thrown when evaluating ondrop of <" << getTag().toString() << ">");
-                    jsDumpError(jsCtx, res);
-                }
-
-                shouldAccept = JS_VALUE_GET_BOOL(res);
+            auto ret{ JS_Call(jsCtx, func, getJSValue(), 1, &dropJsValue) };
 
-                if (JS_VALUE_GET_TAG(res) != JS_TAG_UNDEFINED)
-                    JS_FreeValue(jsCtx, res);
+            if (JS_IsException(ret)) {
+                DBG("Exception thrown when evaluating onacceptdrop of <" << getTag().toString() << ">");
+                jsDumpError(jsCtx, ret);
             }
 
+            shouldAccept = JS_ToBool(jsCtx, ret) > 0;
+
+            JS_FreeValue(jsCtx, ret);
             JS_FreeValue(jsCtx, dropJsValue);
         }
     }
@@ -135,31 +133,22 @@ void ComponentElement::itemDropped(const SourceDetails &dragSourceDetails)
     // Handle dropped component
     if (auto* comp{ dragSourceDetails.sourceComponent.get() }) {
         if (auto* element{ dynamic_cast<Element*>(comp) }) {
-            const auto val{ getAttribute(attr::ondrop) };
+            const auto func{ getAttributeFunction(attr::ondrop) };
 
-            if (val.isVoid())
+            if (JS_IsUndefined(func))
                 return;
 
             JSValue dropJsValue{ element->duplicateJSValue() };
             auto* jsCtx{ context.getJSContext() };
 
-            if (val.isObject()) {
-                if (auto* func{ dynamic_cast<js::Function*>(val.getObject()) }) {
-                    auto ret{ JS_Call(jsCtx, func->getJSValue(), jsValue, 1, &dropJsValue) };
-                    JS_FreeValue(jsCtx, ret); // Ignore returned value
-                }
-            } else {
-                auto res{ context.evalThis(jsValue, val.toString()) };
-
-                if (JS_IsException(res)) {
-                    DBG("Exception thrown when evaluating ondrop of <" << getTag().toString() << ">");
-                    jsDumpError(jsCtx, res);
-                }
+            auto ret{ JS_Call(jsCtx, func, getJSValue(), 1, &dropJsValue) };
 
-                if (JS_VALUE_GET_TAG(res) != JS_TAG_UNDEFINED)
-                    JS_FreeValue(jsCtx, res);
+            if (JS_IsException(ret)) {
+                DBG("Exception thrown when evaluating ondrop of <" << getTag().toString() << ">");
+                jsDumpError(jsCtx, ret);
             }
 
+            JS_FreeValue(jsCtx, ret); // Ignore returned value
             JS_FreeValue(jsCtx, dropJsValue);
         }
     }
@@ -229,6 +218,14 @@ void ComponentElement::populateFontFromStyleProperties(juce::Font& font)
         font.setExtraKerningFactor(static_cast<float>(fontKerning));
 }
 
+bool ComponentElement::isFontStylePropertyChanged() const
+{
+    return isStylePropertyChanged(attr::css::font_family)
+        || isStylePropertyChanged(attr::css::font_style)
+        || isStylePropertyChanged(attr::css::font_size)
+        || isStylePropertyChanged(attr::css::font_kerning);
+}
+
 void ComponentElement::setMouseCursorFromStyleProperties()
 {
     const static std::map<String, MouseCursor::StandardCursorType> cursorTypes {
@@ -283,6 +280,19 @@ void ComponentElement::update()
 
         if (const auto&& [changed, val]{ getStylePropertyChanged(attr::css::click_through) }; changed)
             comp->setInterceptsMouseClicks(val.isVoid() ? true : bool(val), false);
+
+        // layer
+        if (const auto&& [changed, val]{ getStylePropertyChanged(attr::css::layer) }; changed) {
+            if (val.toString() == "cached")
+                comp->setCachedComponentImage(context.getLayerCache().createLayer(*comp).release());
+            else
+                comp->setCachedComponentImage(nullptr);
+        }
+
+        // Only the changed components get repainted. This also
+        // invalidates the cached layers the component belongs to.
+        if (isAppearanceChanged())
+            comp->repaint();
     }
 
     // Drag and drop attributes
@@ -295,16 +305,16 @@ void ComponentElement::update()
     // cursor
     setMouseCursorFromStyleProperties();
 
-    bool createShadow{ false };
+    bool shadowChanged{ false };
 
     // shadow-color
     if (const auto&& [changed, prop]{ getStylePropertyChanged(attr::css::shadow_color) }; changed) {
-        if (prop.isVoid()) {
-            dropShadower.reset();
-        } else {
-            createShadow = true;
+        shadowEnabled = !prop.isVoid();
+
+        if (shadowEnabled)
             shadow.colour = parseColourFromString(prop.toString());
-        }
+
+        shadowChanged = true;
     }
 
     // shadow-radius
@@ -319,10 +329,95 @@ void ComponentElement::update()
     if (const auto&& [changed, prop]{ getStylePropertyChanged(attr::css::shadow_offset_y) }; changed)
         shadow.offset.setY(prop.isVoid() ? 0 : int(prop));
 
-    if (createShadow && dropShadower == nullptr) {
-        dropShadower = std::make_unique<DropShadower>(shadow);
-        dropShadower->setOwner(getComponent());
+    // border-radius
+    if (const auto&& [changed, prop]{ getStylePropertyChanged(attr::css::border_radius) }; changed)
+        shadowCornerRadius = prop.isVoid() ? 0.0f : float(prop);
+
+    shadowChanged = shadowChanged
+                 || isStylePropertyChanged(attr::css::shadow_radius)
+                 || isStylePropertyChanged(attr::css::shadow_offset_x)
+                 || isStylePropertyChanged(attr::css::shadow_offset_y)
+                 || isStylePropertyChanged(attr::css::border_radius);
+
+    if (shadowChanged)
+        repaintShadow();
+}
+
+juce::Rectangle<int> ComponentElement::getShadowBounds()
+{
+    if (auto* comp{ getComponent() })
+        return comp->getBounds().translated(shadow.offset.x, shadow.offset.y).expanded(shadow.radius);
+
+    return {};
+}
+
+void ComponentElement::paintShadow(juce::Graphics& g)
+{
+    auto* comp{ getComponent() };
+
+    if (!shadowEnabled || comp == nullptr || !comp->isVisible())
+        return;
+
+    shadowBounds = getShadowBounds();
+
+    context.getShadowCache().drawShadow(g, comp->getBounds().translated(shadow.offset.x, shadow.offset.y),
+                                        shadow.radius, shadow.colour, shadowCornerRadius);
+}
+
+void ComponentElement::paintChildrenShadows(juce::Graphics& g)
+{
+    auto* container{ getContainerComponent() };
+
+    forEachChild([&](const Element::Ptr& child) {
+        if (!child->isComponentElement())
+            return;
+
+        auto componentElement{ std::dynamic_pointer_cast<ComponentElement>(child) };
+
+        auto* comp{ componentElement->getComponent() };
+
+        if (componentElement->hasShadow() && comp != nullptr && comp->getParentComponent() == container)
+            componentElement->paintShadow(g);
+    }, false);
+}
+
+void ComponentElement::repaintShadow()
+{
+    auto* comp{ getComponent() };
+
+    if (comp == nullptr)
+        return;
+
+    if (auto* parentComp{ comp->getParentComponent() }) {
+        // Both the previous and the new shadow areas must be repainted.
+        if (!shadowBounds.isEmpty())
+            parentComp->repaint(shadowBounds);
+
+        if (shadowEnabled) {
+            if (const auto area{ getShadowBounds() }; !area.isEmpty() && area != shadowBounds)
+                parentComp->repaint(area);
+        }
     }
+
+    if (!shadowEnabled)
+        shadowBounds = {};
+}
+
+bool ComponentElement::isAppearanceChanged() const
+{
+    for (const auto& name : getChangedStyleProperties()) {
+        if (!isLayoutStyleProperty(name))
+            return true;
+    }
+
+    // Volatile attributes (like hover) affect the appearance via
+    // the style properties only, which have been checked above.
+    for (const auto& name : getChangedAttributes()) {
+        if (!attr::isVolatile(name))
+            return true;
+    }
+
+    return false;
 }
 
 void ComponentElement::reconcileElement()
@@ -333,8 +428,12 @@ void ComponentElement::reconcileElement()
     jassert(thisComponent != nullptr);
 
     if (parent.lock() == nullptr) {
-        if (auto owner{ thisComponent->getParentComponent() })
+        if (auto owner{ thisComponent->getParentComponent() }) {
+            if (shadowEnabled)
+                owner->repaint(shadowBounds);
+
             owner->removeChildComponent(thisComponent);
+        }
     } else {
         if (thisComponent->getParentComponent() == nullptr) {
             if (auto parentComponentElement{ getParentComponentElement() }) {
@@ -404,6 +503,16 @@ void ComponentElement::componentMovedOrResized(Component&, bool wasMoved, bool w
 
     if (wasResized)
         evaluateAttributeScript(attr::onresize);
+
+    // The component repaints its own area only.
+    if (shadowEnabled)
+        repaintShadow();
+}
+
+void ComponentElement::componentVisibilityChanged(Component&)
+{
+    if (shadowEnabled)
+        repaintShadow();
 }
 
 //==============================================================================
@@ -5,8 +5,10 @@ namespace vitro {
     This is a base class for all the elements which are also
     UI Components.
 
-    @note JUCE shadow works properly only for rectangular components.
-          When using rounded corners the shadow will not paint properly.
+    @note The shadow is painted by the parent element under its children,
+          which is done by the elements with background (@see ComponentElementWithBackground)
+          and by the scrollable containers (@see ScrollArea, VirtualList).
+          The shadow follows the border-radius of the element.
 
     Attributes:
         visible
@@ -20,6 +22,8 @@ namespace vitro {
         shadow-radius
         shadow-offset-x
         shadow-offset-y
+        border-radius   Used for the shadow's rounded corners.
+        layer           Set to `cached` to cache the rendered subtree.
 */
 class ComponentElement : public LayoutElement,
                          public juce::DragAndDropTarget,
@@ -90,11 +94,12 @@ public:
     /** Update comonent bounds to the layout.
 
         This will reposition this component to the layout bounds calculated.
+        Returns true if the component bounds have changed.
 
         @see LayoutElement::updateLayout
         @see LayoutElement::recalculateLayout
     */
-    void updateComponentBoundsToLayoutNode();
+    bool updateComponentBoundsToLayoutNode();
 
     // juce::DragAndDropTarget
     bool isInterestedInDragSource(const SourceDetails& dragSourceDetails) override;
@@ -104,6 +109,19 @@ public:
 
     bool doesComponentElementAccepDrop() const { return acceptDrop; }
 
+    /** Tell whether this element has a shadow. */
+    bool hasShadow() const { return shadowEnabled; }
+
+    /** Returns the shadow bounds in the parent component coordinates. */
+    juce::Rectangle<int> getShadowBounds();
+
+    /** Paint the shadow of this element.
+
+        The shadow is painted in the parent component coordinates,
+        so this must be called when painting the parent component.
+    */
+    void paintShadow(juce::Graphics& g);
+
     static void registerJSPrototype(JSContext* ctx, JSValue prototype);
 
 protected:
@@ -115,9 +133,19 @@ protected:
     /** Helper to set component's font from style property. */
     void populateFontFromStyleProperties(juce::Font& font);
 
+    /** Tell whether any of the font style properties has changed since the last update. */
+    bool isFontStylePropertyChanged() const;
+
     /** Helper to update component's mouse curtsor. */
     void setMouseCursorFromStyleProperties();
 
+    /** Paint the shadows of the child elements.
+
+        This should be called by the container elements before
+        their children get painted.
+    */
+    void paintChildrenShadows(juce::Graphics& g);
+
     // vitro::Element
     void initialize() override;
     void update() override;
@@ -133,8 +161,16 @@ protected:
 
 private:
 
+    /** Tell whether the last update may have changed the component appearance.
+
+        Layout style changes are not included, since moving or resizing
+        a component repaints it anyway.
+    */
+    bool isAppearanceChanged() const;
+
     // juce::ComponentListener
     void componentMovedOrResized(juce::Component&, bool wasMoved, bool wasResized) override;
+    void componentVisibilityChanged(juce::Component&) override;
 
     // JavaScript methods and properties
     static JSValue js_getViewBounds(JSContext* ctx, JSValueConst self);
@@ -143,9 +179,16 @@ private:
     // Proxy to intercept mouse events and forward them to this component element.
     std::unique_ptr<MouseEventsProxy> mouseEventsProxy{};
 
+    // Repaint the parent area covered by the shadow.
+    void repaintShadow();
+
     // Shadow effect.
-    juce::DropShadow shadow{};
-    std::unique_ptr<juce::DropShadower> dropShadower{};
+    juce::DropShadow shadow{ juce::Colours::black, 4, {} };
+    float shadowCornerRadius{};
+    bool shadowEnabled{ false };
+
+    // Last painted shadow bounds, which must be repainted when moved.
+    juce::Rectangle<int> shadowBounds{};
 
     // Drag and drop
     bool draggable{};
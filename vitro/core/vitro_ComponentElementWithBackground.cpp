@@ -27,65 +27,144 @@ void ComponentElementWithBackground::paintBackground(Graphics& g)
     if (comp == nullptr)
         return;
 
-    const auto width{ comp->getWidth() };
-    const auto height{ comp->getHeight() };
+    const auto bounds{ comp->getLocalBounds() };
+    const auto scale{ g.getInternalContext().getPhysicalPixelScaleFactor() };
 
-    bool solidBackground{};
+    if (!geometry.valid || geometry.bounds != bounds || geometry.scale != scale)
+        updateGeometry(bounds, scale);
 
-    if (backgroundImage.isValid()) {
-        g.saveState();
+    const bool rounded{ borderRadius > 0.0f };
 
-        if (borderRadius > 0) {
-            if (backgroundImageTile) {
+    if (backgroundImageReady) {
+        Graphics::ScopedSaveState state(g);
+
+        if (rounded)
+            g.reduceClipRegion(geometry.fillPath);
+
+        if (backgroundImageTile) {
+            if (backgroundImage.isValid()) {
                 g.setTiledImageFill(backgroundImage, 0, 0, 1.0f);
-                g.fillRoundedRectangle(0.0f, 0.0f, (float)width, (float)height, borderRadius);
-            } else {
-                Path path{};
-                path.addRoundedRectangle(0.0f, 0.0f, (float)width, (float)height, borderRadius);
-                g.reduceClipRegion(path);
-                g.drawImage(backgroundImage, 0, 0, width, height,
-                                             0, 0, backgroundImage.getWidth(), backgroundImage.getHeight());
+                g.fillRect(bounds);
             }
-        } else {
-            if (backgroundImageTile) {
-                g.setTiledImageFill(backgroundImage, 0, 0, 1.0f);
-                g.fillRect(0, 0, width, height);
-            } else {
-                g.drawImage(backgroundImage, 0, 0, width, height,
-                                             0, 0, backgroundImage.getWidth(), backgroundImage.getHeight());
-            }
-
-            g.restoreState();
+        } else if (geometry.scaledImage.isValid()) {
+            // Prescaled image is drawn pixel to pixel.
+            g.drawImageTransformed(geometry.scaledImage, AffineTransform::scale(1.0f / scale));
         }
+    } else if (gradient || backgroundColour) {
+        if (gradient)
+            g.setGradientFill(colourGradient);
+        else
+            g.setColour(*backgroundColour);
 
-    } else if (gradient) {
-        g.setGradientFill(colourGradient);
-        solidBackground = true;
-    } else if (backgroundColour) {
-        g.setColour(*backgroundColour);
-        solidBackground = true;
-    }
-
-    if (solidBackground) {
-        if (borderRadius > 0.0f)
-            g.fillRoundedRectangle(0.0f, 0.0f, (float)width, (float)height, borderRadius);
+        if (rounded)
+            g.fillPath(geometry.fillPath);
         else
-            g.fillRect(0, 0, width, height);
+            g.fillRect(bounds);
     }
 
     if (borderColour && (!backgroundColour || *backgroundColour != *borderColour)) {
         g.setColour(*borderColour);
 
-        if (borderRadius > 0.0f) {
-            const float offset{ 0.5f * borderWidth };
+        if (rounded)
+            g.fillPath(geometry.borderPath);
+        else
+            g.drawRect(bounds, (int)borderWidth);
+    }
 
-            g.drawRoundedRectangle(offset, offset,
-                float(width) - borderWidth, float(height) - borderWidth,
-                borderRadius, borderWidth);
-        } else {
-            g.drawRect(comp->getLocalBounds(), (int)borderWidth);
+    paintChildrenShadows(g);
+}
+
+void ComponentElementWithBackground::updateGeometry(const juce::Rectangle<int>& bounds, float scale)
+{
+    geometry.bounds = bounds;
+    geometry.scale = scale;
+    geometry.valid = true;
+
+    geometry.fillPath.clear();
+    geometry.borderPath.clear();
+    geometry.scaledImage = {};
+
+    const auto area{ bounds.toFloat() };
+
+    if (borderRadius > 0.0f) {
+        geometry.fillPath.addRoundedRectangle(area, borderRadius);
+
+        // The border is stroked inside the component bounds.
+        Path outline{};
+        outline.addRoundedRectangle(area.reduced(0.5f * borderWidth), borderRadius);
+        PathStrokeType(borderWidth).createStrokedPath(geometry.borderPath, outline);
+    }
+
+    if (!backgroundImageReady)
+        return;
+
+    auto& imageCache{ context.getLoader().getImageCache() };
+
+    if (backgroundImageTile) {
+        // The tiles are drawn from the full resolution image, so the cache keeps it.
+        if (auto source{ imageCache.get(backgroundImageLocation, true) }; source.isValid())
+            backgroundImage = source;
+    } else if (!bounds.isEmpty()) {
+        const int width{ juce::roundToInt((float)bounds.getWidth() * scale) };
+        const int height{ juce::roundToInt((float)bounds.getHeight() * scale) };
+
+        // Rescale from the nearest downscaled variant rather than the full resolution image.
+        const auto variant{ imageCache.getVariant(backgroundImageLocation, backgroundImage, width, height) };
+
+        if (variant.isValid()) {
+            geometry.scaledImage = variant.getWidth() == width && variant.getHeight() == height
+                                 ? variant
+                                 : variant.rescaled(width, height, Graphics::highResamplingQuality);
+        } else if (const auto largest{ imageCache.getLargestVariant(backgroundImageLocation) }; largest.isValid()) {
+            // The element has outgrown the cached variants, whose source has been released.
+            // The largest one is drawn upscaled while the source is being loaded again.
+            geometry.scaledImage = largest.rescaled(width, height, Graphics::mediumResamplingQuality);
+
+            if (!backgroundImageLoading)
+                requestBackgroundImage();
         }
+
+        // The source image is held by the cache (unless evicted), so it is not kept here.
+        backgroundImage = {};
     }
+
+    // The image has been evicted from the cache, so it must be loaded again.
+    if (!backgroundImage.isValid() && !geometry.scaledImage.isValid() && !bounds.isEmpty() && !backgroundImageLoading)
+        requestBackgroundImage();
+}
+
+void ComponentElementWithBackground::requestBackgroundImage()
+{
+    std::weak_ptr<Element> weakSelf{ weak_from_this() };
+
+    backgroundImage = context.getLoader().loadImageAsync(backgroundImageLocation,
+        [weakSelf, location{ backgroundImageLocation }](const juce::Image& image) {
+            if (auto self{ std::dynamic_pointer_cast<ComponentElementWithBackground>(weakSelf.lock()) })
+                self->backgroundImageLoaded(location, image);
+        });
+
+    backgroundImageLoading = !backgroundImage.isValid();
+
+    // An upscaled variant, if any, is drawn until the image is loaded.
+    backgroundImageReady = backgroundImage.isValid() || geometry.scaledImage.isValid();
+
+    if (backgroundImage.isValid())
+        geometry.valid = false;
+}
+
+void ComponentElementWithBackground::backgroundImageLoaded(const juce::String& location, const juce::Image& image)
+{
+    // The background image may have been changed while this one was loading.
+    if (location != backgroundImageLocation)
+        return;
+
+    backgroundImage = image;
+    backgroundImageReady = image.isValid();
+    backgroundImageLoading = false;
+    geometry.valid = false;
+
+    if (auto* comp{ getComponent() })
+        comp->repaint();
 }
 
 void ComponentElementWithBackground::update()
@@ -118,8 +197,14 @@ void ComponentElementWithBackground::update()
 
     // background-image
     if (const auto&& [changed, prop]{ getStylePropertyChanged(attr::css::background_image) }; changed) {
-            backgroundImage = prop.isVoid() ? juce::Image()
-                                            : context.getLoader().loadImage(prop.toString());
+        backgroundImageLocation = prop.isVoid() ? String() : prop.toString();
+        backgroundImage = {};
+        backgroundImageReady = false;
+        backgroundImageLoading = false;
+        geometry.scaledImage = {};
+
+        if (backgroundImageLocation.isNotEmpty())
+            requestBackgroundImage();
     }
 
     // background-image-tile
@@ -141,6 +226,13 @@ void ComponentElementWithBackground::update()
     // border-width
     if (const auto&& [changed, prop]{ getStylePropertyChanged(attr::css::border_width) }; changed)
         borderWidth = prop;
+
+    if (isStylePropertyChanged(attr::css::background_image)
+        || isStylePropertyChanged(attr::css::background_image_tile)
+        || isStylePropertyChanged(attr::css::border_radius)
+        || isStylePropertyChanged(attr::css::border_width)) {
+        geometry.valid = false;
+    }
 }
 
 } // namespace vitro
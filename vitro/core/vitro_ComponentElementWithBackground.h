@@ -8,6 +8,11 @@ namespace vitro {
 
     @note Currently when background-image is set it will override the background-color property.
 
+    @note The background image is decoded asynchronously. Until it is ready
+          the background color (if any) is painted instead. When the element
+          outgrows the cached image variants, the largest one is painted
+          upscaled while the image is being decoded again.
+
     Style attributes:
         background-color
         background-image
@@ -32,7 +37,40 @@ protected:
 
 private:
 
+    /** Background geometry cached for the component size.
+
+        This avoids rebuilding the paths and rescaling
+        the background image on each paint.
+    */
+    struct Geometry final
+    {
+        juce::Rectangle<int> bounds{};
+        float scale{};
+
+        juce::Path fillPath{};
+        juce::Path borderPath{};
+
+        // Background image rescaled to the component physical size
+        // from the nearest cached variant.
+        juce::Image scaledImage{};
+
+        bool valid{ false };
+    };
+
+    void updateGeometry(const juce::Rectangle<int>& bounds, float scale);
+
+    // Load the background image, asynchronously unless cached.
+    void requestBackgroundImage();
+    void backgroundImageLoaded(const juce::String& location, const juce::Image& image);
+
+    Geometry geometry{};
+
+    // Full resolution background image, which is only kept
+    // when tiled or until the scaled image gets created.
     juce::Image backgroundImage{};
+    juce::String backgroundImageLocation{};
+    bool backgroundImageReady{ false };
+    bool backgroundImageLoading{ false };
     bool backgroundImageTile{ false };
 
     std::optional<juce::Colour> backgroundColour{};
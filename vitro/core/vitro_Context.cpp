@@ -169,9 +169,8 @@ static JSModuleDef* jsModuleLoader(JSContext *ctx, const char *module_name, void
 
     JSModuleDef* m{ nullptr };
 
-    /* compile the module */
-    auto func_val = JS_Eval(ctx, src.toRawUTF8(), src.length(), module_name,
-                            JS_EVAL_TYPE_MODULE | JS_EVAL_FLAG_COMPILE_ONLY);
+    /* compile the module, or load it from the bytecode cache */
+    auto func_val = context->getBytecodeCache().compile(ctx, src, String::fromUTF8(module_name), JS_EVAL_TYPE_MODULE);
 
     if (JS_IsException(func_val)) {
         jsDumpError(ctx, func_val);
@@ -245,20 +244,133 @@ static JSValue js_setTimeout(JSContext* ctx, [[maybe_unused]] JSValueConst this_
     return JS_UNDEFINED;
 }
 
+static JSValue js_getHeapStatistics(JSContext* ctx, [[maybe_unused]] JSValueConst this_val, int, JSValueConst*)
+{
+    auto* context{ Context::getContextFromJSContext(ctx) };
+
+    if (!context)
+        return JS_ThrowInternalError(ctx, "Unable to get UI context from JS context");
+
+    return js::varToJSValue(ctx, context->getHeapStatistics().toVar());
+}
+
+//==============================================================================
+
+/** Idle-time garbage collector.
+
+    This runs the JavaScript garbage collection on the message thread
+    when it has spare time. The message thread is considered busy when
+    the timer ticks get delayed.
+*/
+class IdleGC final : private juce::Timer
+{
+public:
+
+    IdleGC(JSRuntime* rt)
+        : runtime{ rt }
+    {
+    }
+
+    ~IdleGC() override
+    {
+        stopTimer();
+    }
+
+    void setInterval(int milliseconds)
+    {
+        interval = juce::jmax(0, milliseconds);
+
+        if (active)
+            start();
+    }
+
+    void start()
+    {
+        active = true;
+
+        if (interval > 0) {
+            lastTickTime = lastCollectionTime = Time::getMillisecondCounterHiRes();
+            startTimer(tickInterval);
+        } else {
+            stopTimer();
+        }
+    }
+
+    void stop()
+    {
+        active = false;
+        stopTimer();
+    }
+
+    int getNumCollections() const { return numCollections; }
+
+private:
+
+    // juce::Timer
+    void timerCallback() override
+    {
+        const auto now{ Time::getMillisecondCounterHiRes() };
+        const auto lateness{ now - lastTickTime - tickInterval };
+        lastTickTime = now;
+
+        if (lateness > maxTickLateness || now - lastCollectionTime < interval)
+            return;
+
+        // Do not interfere with the user interaction
+        if (Desktop::getInstance().getNumDraggingMouseSources() > 0)
+            return;
+
+        JS_RunGC(runtime);
+
+        lastCollectionTime = Time::getMillisecondCounterHiRes();
+        ++numCollections;
+    }
+
+    constexpr static int tickInterval = 50;
+    constexpr static double maxTickLateness = 8.0;
+
+    JSRuntime* runtime;
+    int interval{ 1000 };
+    bool active{ false };
+    double lastTickTime{};
+    double lastCollectionTime{};
+    int numCollections{};
+};
+
 //==============================================================================
 
 struct Context::Impl final
 {
     Context& self;
 
+    // Layout nodes and layers are released by the elements,
+    // so these must outlive the elements factory.
+    LayoutNodePool layoutNodePool{};
+    LayerCache layerCache{};
+
     Loader loader{};
     Stylesheet stylesheet{};
     LookAndFeel lookAndFeel{};
     ElementsFactory elementsFactory;
+    Instrumentation instrumentation{};
+    TextMetrics textMetrics{};
+    DrawableCache drawableCache{};
+    ShadowCache shadowCache{};
+    BytecodeCache bytecodeCache{};
+
+    // Elements' JS objects get released when the runtime is freed,
+    // so these must outlive the runtime.
+    std::map<JSClassID, int> numJSObjects{};
+    std::map<JSClassID, String> jsClassNames{};
 
     std::unique_ptr<JSRuntime, void(*)(JSRuntime*)> jsRuntime;
     std::unique_ptr<JSContext, void(*)(JSContext*)> jsContext;
 
+    // Holds the runtime atoms, so it must be released before the runtime.
+    AtomCache atomCache;
+
+    IdleGC idleGC;
+
     std::unique_ptr<TimerPool> timerPool;
 
     Impl(Context& ctx)
@@ -266,6 +378,8 @@ struct Context::Impl final
           elementsFactory(ctx),
           jsRuntime(JS_NewRuntime(), JS_FreeRuntime),
           jsContext(JS_NewContext(jsRuntime.get()), JS_FreeContext),
+          atomCache(jsRuntime.get()),
+          idleGC(jsRuntime.get()),
           timerPool{ std::make_unique<TimerPool>() }
     {
         JS_SetModuleLoaderFunc(jsRuntime.get(), nullptr, jsModuleLoader, &self);
@@ -273,9 +387,27 @@ struct Context::Impl final
     }
 
     ~Impl()
+    {
+        releaseJS();
+    }
+
+    /** Release the JavaScript context and runtime.
+
+        Freeing the runtime finalizes the remaining elements' JS objects,
+        which access the context, so this must be done while the context
+        implementation is still intact.
+    */
+    void releaseJS()
     {
         // Make sure to delete all the pending timers first.
         timerPool.reset();
+        idleGC.stop();
+
+        // The cached atoms must be released before the runtime.
+        atomCache.clear();
+
+        jsContext.reset();
+        jsRuntime.reset();
     }
 
     void initialize()
@@ -286,23 +418,21 @@ struct Context::Impl final
     JSValue eval(StringRef script, StringRef fileName)
     {
         const int evalFlags{ JS_DetectModule(script, script.length()) ? JS_EVAL_TYPE_MODULE : JS_EVAL_TYPE_GLOBAL };
-
-      	if ((evalFlags & JS_EVAL_TYPE_MASK) == JS_EVAL_TYPE_MODULE) {
-            JSValue val{ JS_Eval(jsContext.get(), script, script.length(), fileName, evalFlags | JS_EVAL_FLAG_COMPILE_ONLY) };
-
-            if (!JS_IsException(val)) {
-                /*
-                constexpr int useRealPath = 1;
-                constexpr int isMain = 1;
-                js_module_set_import_meta(jsContext.get(), val, useRealPath, isMain);
-                */
-                val = JS_EvalFunction(jsContext.get(), val);
-            }
-
-            return val;
+        const bool isModule{ (evalFlags & JS_EVAL_TYPE_MASK) == JS_EVAL_TYPE_MODULE };
+
+        // Scripts get compiled, or loaded from the bytecode cache, and then evaluated.
+        JSValue val{ bytecodeCache.compile(jsContext.get(), String(script), isModule ? String(fileName) : String(), evalFlags) };
+
+        if (!JS_IsException(val)) {
+            /*
+            constexpr int useRealPath = 1;
+            constexpr int isMain = 1;
+            js_module_set_import_meta(jsContext.get(), val, useRealPath, isMain);
+            */
+            val = JS_EvalFunction(jsContext.get(), val);
         }
 
-        return JS_Eval(jsContext.get(), script, script.length(), "", evalFlags);
+        return val;
     }
 
     JSValue evalThis(JSValueConst thisObj, StringRef script, StringRef fileName)
@@ -378,6 +508,8 @@ struct Context::Impl final
 
         /* Embed this context object */
         {
+            JS_SetContextOpaque(ctx, &self);
+
             auto context{ JS_NewObject(ctx) };
             JS_SetOpaque(context, &self);
             JS_SetPropertyStr(ctx, global, contextInternalLiteral, context);
@@ -396,6 +528,12 @@ struct Context::Impl final
             JS_SetPropertyStr(ctx, global, "setTimeout", setTimeout);
         }
 
+        /* getHeapStatistics */
+        {
+            auto getHeapStatistics{ JS_NewCFunction(ctx, js_getHeapStatistics, "getHeapStatistics", 0) };
+            JS_SetPropertyStr(ctx, global, "getHeapStatistics", getHeapStatistics);
+        }
+
         JS_FreeValue(ctx, global);
     }
 };
@@ -405,7 +543,18 @@ struct Context::Impl final
 Context::Context()
     : d{ std::make_unique<Impl>(*this) }
 {
-    d->initialize();
+    // Elements class IDs are allocated process-wide by the first
+    // initialized context, whereas contexts may be created on
+    // different threads (@see ContextPool).
+    {
+        static juce::CriticalSection initializationLock{};
+        const juce::ScopedLock lock{ initializationLock };
+
+        d->initialize();
+    }
+
+    if (MessageManager::existsAndIsCurrentThread())
+        attachToCurrentThread();
 }
 
 Context::~Context()
@@ -414,6 +563,9 @@ Context::~Context()
     // context implementation, since the elements deletion will
     // attempt to access the context (freeing JSValues).
     d->elementsFactory.clearStashedElements();
+
+    // The JS objects still referenced by the script get finalized here.
+    d->releaseJS();
 }
 
 const Loader& Context::getLoader() const
@@ -456,6 +608,51 @@ ElementsFactory& Context::getElementsFactory()
     return d->elementsFactory;
 }
 
+const Instrumentation& Context::getInstrumentation() const
+{
+    return d->instrumentation;
+}
+
+Instrumentation& Context::getInstrumentation()
+{
+    return d->instrumentation;
+}
+
+TextMetrics& Context::getTextMetrics()
+{
+    return d->textMetrics;
+}
+
+LayoutNodePool& Context::getLayoutNodePool()
+{
+    return d->layoutNodePool;
+}
+
+LayerCache& Context::getLayerCache()
+{
+    return d->layerCache;
+}
+
+DrawableCache& Context::getDrawableCache()
+{
+    return d->drawableCache;
+}
+
+ShadowCache& Context::getShadowCache()
+{
+    return d->shadowCache;
+}
+
+BytecodeCache& Context::getBytecodeCache()
+{
+    return d->bytecodeCache;
+}
+
+AtomCache& Context::getAtomCache()
+{
+    return d->atomCache;
+}
+
 JSRuntime* Context::getJSRuntime()
 {
     return d->jsRuntime.get();
@@ -466,6 +663,142 @@ JSContext* Context::getJSContext()
     return d->jsContext.get();
 }
 
+void Context::setJSMemoryLimit(size_t numBytes)
+{
+    JS_SetMemoryLimit(d->jsRuntime.get(), numBytes > 0 ? numBytes : (size_t)-1);
+}
+
+void Context::setJSGCThreshold(size_t numBytes)
+{
+    JS_SetGCThreshold(d->jsRuntime.get(), numBytes);
+}
+
+void Context::setIdleGCInterval(int milliseconds)
+{
+    d->idleGC.setInterval(milliseconds);
+}
+
+void Context::runGC()
+{
+    JS_RunGC(d->jsRuntime.get());
+}
+
+Context::HeapStatistics Context::getHeapStatistics()
+{
+    JSMemoryUsage usage{};
+    JS_ComputeMemoryUsage(d->jsRuntime.get(), &usage);
+
+    HeapStatistics stats{};
+    stats.mallocSize        = usage.malloc_size;
+    stats.mallocLimit       = usage.malloc_limit;
+    stats.memoryUsedSize    = usage.memory_used_size;
+    stats.numObjects        = usage.obj_count;
+    stats.objectsSize       = usage.obj_size;
+    stats.numStrings        = usage.str_count;
+    stats.stringsSize       = usage.str_size;
+    stats.numAtoms          = usage.atom_count;
+    stats.atomsSize         = usage.atom_size;
+    stats.numFunctions      = usage.js_func_count;
+    stats.numArrays         = usage.array_count;
+    stats.numBinaryObjects  = usage.binary_object_count;
+    stats.binaryObjectsSize = usage.binary_object_size;
+    stats.numIdleCollections = d->idleGC.getNumCollections();
+
+    for (const auto& [classID, count] : d->numJSObjects) {
+        if (count <= 0)
+            continue;
+
+        const auto it{ d->jsClassNames.find(classID) };
+        const auto className{ it != d->jsClassNames.end() ? it->second : "class " + String(classID) };
+        stats.elementObjects[className] += count;
+    }
+
+    return stats;
+}
+
+void Context::attachToCurrentThread()
+{
+    // The JavaScript runtime checks the stack overflow relatively to
+    // the stack of the thread it has been attached to.
+    JS_UpdateStackTop(d->jsRuntime.get());
+
+    if (MessageManager::existsAndIsCurrentThread())
+        d->idleGC.start();
+}
+
+void Context::jsObjectCreated(JSClassID classID)
+{
+    ++d->numJSObjects[classID];
+}
+
+void Context::jsObjectReleased(JSClassID classID)
+{
+    --d->numJSObjects[classID];
+}
+
+void Context::setJSClassName(JSClassID classID, const String& className)
+{
+    d->jsClassNames[classID] = className;
+}
+
+juce::var Context::HeapStatistics::toVar() const
+{
+    auto* obj{ new DynamicObject() };
+    obj->setProperty("mallocSize", mallocSize);
+    obj->setProperty("mallocLimit", mallocLimit);
+    obj->setProperty("memoryUsedSize", memoryUsedSize);
+    obj->setProperty("numObjects", numObjects);
+    obj->setProperty("objectsSize", objectsSize);
+    obj->setProperty("numStrings", numStrings);
+    obj->setProperty("stringsSize", stringsSize);
+    obj->setProperty("numAtoms", numAtoms);
+    obj->setProperty("atomsSize", atomsSize);
+    obj->setProperty("numFunctions", numFunctions);
+    obj->setProperty("numArrays", numArrays);
+    obj->setProperty("numBinaryObjects", numBinaryObjects);
+    obj->setProperty("binaryObjectsSize", binaryObjectsSize);
+    obj->setProperty("numIdleCollections", numIdleCollections);
+
+    auto* elements{ new DynamicObject() };
+
+    for (const auto& [className, count] : elementObjects)
+        elements->setProperty(className, count);
+
+    obj->setProperty("elementObjects", var(elements));
+
+    return var(obj);
+}
+
+namespace {
+
+// Class IDs are shared between all the JavaScript runtimes,
+// so the types registry is process-wide.
+std::array<std::atomic<const std::type_info*>, Context::maxJSClassIDs>& getJSClassTypes()
+{
+    static std::array<std::atomic<const std::type_info*>, Context::maxJSClassIDs> types{};
+    return types;
+}
+
+} // anonymous namespace
+
+const std::type_info* Context::getJSClassType(JSClassID classID)
+{
+    if (classID == 0 || classID >= maxJSClassIDs)
+        return nullptr;
+
+    return getJSClassTypes()[classID].load(std::memory_order_acquire);
+}
+
+void Context::registerJSClassType(JSClassID classID, const std::type_info& type)
+{
+    if (classID >= maxJSClassIDs) {
+        jassertfalse;
+        return;
+    }
+
+    getJSClassTypes()[classID].store(&type, std::memory_order_release);
+}
+
 JSValue Context::eval(StringRef script, StringRef fileName)
 {
     return d->eval(script, fileName);
@@ -516,6 +849,9 @@ void Context::callAfterDelay(int milliseconds, const std::function<void()>& f)
 
 Context* Context::getContextFromJSContext(JSContext* ctx)
 {
+    if (auto* opaque{ JS_GetContextOpaque(ctx) })
+        return static_cast<Context*>(opaque);
+
     Context* contextPtr{ nullptr };
     auto global{ JS_GetGlobalObject(ctx) };
     auto obj{ JS_GetPropertyStr(ctx, global, contextInternalLiteral) };
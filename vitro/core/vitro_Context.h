@@ -24,6 +24,34 @@ class Context final
 {
 public:
 
+    /** JavaScript heap statistics.
+
+        @see getHeapStatistics
+    */
+    struct HeapStatistics final
+    {
+        juce::int64 mallocSize{};           // Memory allocated by the JavaScript engine
+        juce::int64 mallocLimit{};          // Memory limit, -1 if not limited
+        juce::int64 memoryUsedSize{};       // Memory used by the JavaScript objects
+        juce::int64 numObjects{};
+        juce::int64 objectsSize{};
+        juce::int64 numStrings{};
+        juce::int64 stringsSize{};
+        juce::int64 numAtoms{};
+        juce::int64 atomsSize{};
+        juce::int64 numFunctions{};
+        juce::int64 numArrays{};
+        juce::int64 numBinaryObjects{};
+        juce::int64 binaryObjectsSize{};
+        int numIdleCollections{};           // Number of garbage collections run while idle
+
+        // Number of the live elements' JavaScript objects per element class.
+        std::map<juce::String, int> elementObjects{};
+
+        /** Convert the statistics to an object. */
+        juce::var toVar() const;
+    };
+
     /** Construct the context.
 
         This will initialize the new elements factory, stylesheet and JavaScript context.
@@ -49,10 +77,41 @@ public:
     const ElementsFactory& getElementsFactory() const;
     ElementsFactory& getElementsFactory();
 
+    /** Returns the performance counters of this context. */
+    const Instrumentation& getInstrumentation() const;
+    Instrumentation& getInstrumentation();
+
+    /** Returns the text metrics cache shared by the elements of this context. */
+    TextMetrics& getTextMetrics();
+
+    /** Returns the pool the layout nodes of this context are allocated from. */
+    LayoutNodePool& getLayoutNodePool();
+
+    /** Returns the cache of the rasterized component layers. */
+    LayerCache& getLayerCache();
+
+    /** Returns the cache of the parsed and rasterized SVG drawables. */
+    DrawableCache& getDrawableCache();
+
+    /** Returns the cache of the rendered drop shadows. */
+    ShadowCache& getShadowCache();
+
+    /** Returns the cache of the compiled scripts and modules. */
+    BytecodeCache& getBytecodeCache();
+
+    /** Returns the cache of the attribute and property names atoms. */
+    AtomCache& getAtomCache();
+
 
     JSRuntime* getJSRuntime();
     JSContext* getJSContext();
 
+    /** Maximum number of the JavaScript class IDs used by the elements. */
+    constexpr static JSClassID maxJSClassIDs = 1024;
+
+    /** Returns the native type of the registered element class, or nullptr. */
+    static const std::type_info* getJSClassType(JSClassID classID);
+
     /** Register JavaScript class prototype for the elements.
 
         The class must have a static member jsClassID, which will be
@@ -80,6 +139,9 @@ public:
             jassert (res == 0);
         }
 
+        registerJSClassType(T::jsClassID, typeid(T));
+        setJSClassName(T::jsClassID, className);
+
         auto* ctx{ getJSContext() };
 
         auto proto{ JS_NewObject(ctx) };
@@ -87,32 +149,67 @@ public:
         JS_SetClassProto(ctx, T::jsClassID, proto);
     }
 
-    /** Returns inner reference object. */
+    /** Returns inner reference object.
+
+        This returns nullptr if the object is not an element's object.
+    */
     template<class T>
     static typename Element::JSObjectRef* getJSObjectRef(JSValue obj)
     {
         void* opaque{ nullptr };
         const JSClassID classID{ JS_GetClassID(obj, &opaque) };
-        juce::ignoreUnused(classID);
-
-        // @todo We have to check that classID is among registered ones
 
-        if (/* classID == T::jsClassID && */opaque != nullptr)
+        // Objects of other classes may hold opaque pointers of different types.
+        if (opaque != nullptr && getJSClassType(classID) != nullptr)
             return static_cast<typename Element::JSObjectRef*>(opaque);
 
         return nullptr;
     }
 
+    /** Returns the element of the JavaScript object.
+
+        This returns nullptr if the object is not an element's object,
+        if the element is not of type T, or if the element no longer exists.
+    */
     template<class T>
     static typename std::shared_ptr<T> getJSNativeObject(JSValue obj)
     {
-        if (auto* ref{ getJSObjectRef<T>(obj) }) {
-            if (auto elementPtr{ ref->element.lock() }) {
-                return std::dynamic_pointer_cast<T>(elementPtr);
-            }
-        }
+        void* opaque{ nullptr };
+        const JSClassID classID{ JS_GetClassID(obj, &opaque) };
+        const auto* classType{ getJSClassType(classID) };
 
-        return nullptr;
+        if (opaque == nullptr || classType == nullptr)
+            return nullptr;
+
+        auto elementPtr{ static_cast<typename Element::JSObjectRef*>(opaque)->element.lock() };
+
+        if (elementPtr == nullptr)
+            return nullptr;
+
+        if constexpr (std::is_same_v<T, Element>) {
+            return elementPtr;
+        } else {
+            // Whether the class derives from T is resolved once per class.
+            // 0 - unknown, 1 - derived, 2 - not derived.
+            static std::array<std::atomic<juce::uint8>, maxJSClassIDs> derivedClasses{};
+
+            const auto derived{ derivedClasses[classID].load(std::memory_order_relaxed) };
+
+            if (derived == 1)
+                return std::static_pointer_cast<T>(elementPtr);
+
+            if (derived == 2)
+                return nullptr;
+
+            auto ptr{ std::dynamic_pointer_cast<T>(elementPtr) };
+
+            // Only an element of the exact registered type represents its class,
+            // otherwise it may be of a derived type sharing the same class ID.
+            if (typeid(*elementPtr) == *classType)
+                derivedClasses[classID].store(ptr != nullptr ? 1 : 2, std::memory_order_relaxed);
+
+            return ptr;
+        }
     }
 
     /** Evaluate JavaScript code.
@@ -156,8 +253,67 @@ public:
     /** Retrieve the this Context object from the JSContext. */
     static Context* getContextFromJSContext(JSContext* ctx);
 
+    /** Limit the memory the JavaScript engine can allocate.
+
+        Allocations beyond the limit will throw an out of memory exception
+        in the script. Zero value removes the limit.
+    */
+    void setJSMemoryLimit(size_t numBytes);
+
+    /** Assign the JavaScript garbage collection threshold.
+
+        The engine runs the garbage collector when the allocated memory
+        exceeds the threshold, and then moves the threshold to 1.5 times
+        the memory remaining allocated.
+    */
+    void setJSGCThreshold(size_t numBytes);
+
+    /** Assign the minimal interval between the idle garbage collections.
+
+        The garbage collector runs on the message thread when it has spare time
+        and there is no mouse dragging in progress, so that the collections triggered
+        by the allocations are less likely to happen during user interaction.
+        Zero value disables the idle garbage collection.
+
+        @note The idle collection is only active for the contexts attached
+              to the message thread (@see attachToCurrentThread).
+    */
+    void setIdleGCInterval(int milliseconds);
+
+    /** Run the JavaScript garbage collector. */
+    void runGC();
+
+    /** Returns the JavaScript heap statistics.
+
+        @note This walks through all the JavaScript objects, so it should not
+              be called on every frame.
+    */
+    HeapStatistics getHeapStatistics();
+
+    /** Attach the context to the current thread.
+
+        This must be called when a context created on a different thread
+        is going to be used on the current one. This is done automatically
+        for the contexts created on the message thread.
+
+        @see ContextPool
+    */
+    void attachToCurrentThread();
+
 private:
 
+    friend struct Element::JSObjectRef;
+
+    /** Track the number of the elements' JavaScript objects. */
+    void jsObjectCreated(JSClassID classID);
+    void jsObjectReleased(JSClassID classID);
+
+    /** Associate the class ID with its name for the heap statistics. */
+    void setJSClassName(JSClassID classID, const juce::String& className);
+
+    /** Associate the element class ID with its native type. */
+    static void registerJSClassType(JSClassID classID, const std::type_info& type);
+
     struct Impl;
     std::unique_ptr<Impl> d;
 
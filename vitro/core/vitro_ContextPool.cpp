@@ -0,0 +1,179 @@
+namespace vitro {
+
+/** Background thread that keeps the pool filled. */
+class ContextPool::Worker final : public juce::Thread
+{
+public:
+
+    Worker(ContextPool& contextPool)
+        : juce::Thread("vitro::ContextPool"),
+          pool{ contextPool }
+    {
+    }
+
+    ~Worker() override
+    {
+        stopThread(10000);
+    }
+
+    void run() override
+    {
+        while (!threadShouldExit()) {
+            {
+                const juce::ScopedLock scopedLock{ pool.lock };
+                pool.preparing = (int)pool.contexts.size() < pool.numPreparedContexts;
+            }
+
+            if (!pool.preparing) {
+                wait(-1);
+                continue;
+            }
+
+            auto context{ pool.createContext() };
+
+            {
+                const juce::ScopedLock scopedLock{ pool.lock };
+                pool.contexts.push_back(std::move(context));
+                pool.preparing = false;
+            }
+
+            pool.contextPrepared.signal();
+        }
+    }
+
+private:
+
+    ContextPool& pool;
+};
+
+//==============================================================================
+
+JUCE_IMPLEMENT_SINGLETON(ContextPool)
+
+ContextPool::ContextPool()
+    : worker{ std::make_unique<Worker>(*this) }
+{
+}
+
+ContextPool::~ContextPool()
+{
+    // Stop the worker before releasing the prepared contexts.
+    worker.reset();
+    contexts.clear();
+
+    clearSingletonInstance();
+}
+
+std::unique_ptr<Context> ContextPool::acquire()
+{
+    std::unique_ptr<Context> context{};
+
+    while (context == nullptr) {
+        {
+            const juce::ScopedLock scopedLock{ lock };
+
+            if (!contexts.empty()) {
+                context = std::move(contexts.back());
+                contexts.pop_back();
+                ++numHits;
+                break;
+            }
+
+            if (!preparing)
+                break;
+        }
+
+        // A context is being prepared, which is quicker than creating a new one.
+        contextPrepared.wait(-1);
+    }
+
+    if (context == nullptr) {
+        context = createContext();
+
+        const juce::ScopedLock scopedLock{ lock };
+        ++numMisses;
+    }
+
+    context->attachToCurrentThread();
+
+    return context;
+}
+
+void ContextPool::prepare()
+{
+    {
+        const juce::ScopedLock scopedLock{ lock };
+
+        if (numPreparedContexts == 0)
+            return;
+    }
+
+    if (!worker->isThreadRunning())
+        worker->startThread();
+
+    worker->notify();
+}
+
+void ContextPool::setNumPreparedContexts(int numContexts)
+{
+    std::vector<std::unique_ptr<Context>> released{};
+
+    {
+        const juce::ScopedLock scopedLock{ lock };
+        numPreparedContexts = juce::jmax(0, numContexts);
+
+        while ((int)contexts.size() > numPreparedContexts) {
+            released.push_back(std::move(contexts.back()));
+            contexts.pop_back();
+        }
+    }
+
+    prepare();
+}
+
+int ContextPool::getNumPreparedContexts() const
+{
+    const juce::ScopedLock scopedLock{ lock };
+    return numPreparedContexts;
+}
+
+int ContextPool::getNumAvailableContexts() const
+{
+    const juce::ScopedLock scopedLock{ lock };
+    return (int)contexts.size();
+}
+
+int ContextPool::getNumHits() const
+{
+    const juce::ScopedLock scopedLock{ lock };
+    return numHits;
+}
+
+int ContextPool::getNumMisses() const
+{
+    const juce::ScopedLock scopedLock{ lock };
+    return numMisses;
+}
+
+double ContextPool::getAverageCreationTime() const
+{
+    const juce::ScopedLock scopedLock{ lock };
+    return numCreated > 0 ? totalCreationTime / numCreated : 0.0;
+}
+
+std::unique_ptr<Context> ContextPool::createContext()
+{
+    const auto startTime{ juce::Time::getMillisecondCounterHiRes() };
+
+    auto context{ std::make_unique<Context>() };
+
+    const auto elapsed{ juce::Time::getMillisecondCounterHiRes() - startTime };
+
+    const juce::ScopedLock scopedLock{ lock };
+    totalCreationTime += elapsed;
+    ++numCreated;
+
+    return context;
+}
+
+} // namespace vitro
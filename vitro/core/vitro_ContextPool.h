@@ -0,0 +1,92 @@
+namespace vitro {
+
+/** Pool of prepared contexts.
+
+    Creating a context involves creating the JavaScript runtime and
+    registering all the elements classes with their prototypes, which
+    takes noticeable time. The pool prepares the contexts on a background
+    thread ahead of time, so that a view container can take a fully
+    initialized context when loading the UI.
+
+    The pool is a singleton shared by all the view containers. It outlives
+    the view containers (and so the plugin editors), and gets deleted when
+    JUCE shuts down. In a plugin the processor can call prepare(), so that
+    a context is ready when the editor gets opened for the first time.
+
+    @see ViewContainer::loadFromResource
+*/
+class ContextPool final : private juce::DeletedAtShutdown
+{
+public:
+
+    ContextPool();
+    ~ContextPool() override;
+
+    JUCE_DECLARE_SINGLETON(ContextPool, false)
+
+    /** Returns a prepared context.
+
+        If there is no prepared context available, a new one will
+        be created (or the one being prepared will be awaited).
+        The pool does not get refilled until prepare() is called,
+        so that preparing the next context does not compete with
+        the UI load.
+
+        The returned context gets attached to the calling thread.
+
+        @note This must be called on the thread that will use the context,
+              normally the message thread.
+    */
+    std::unique_ptr<Context> acquire();
+
+    /** Start preparing the contexts in background. */
+    void prepare();
+
+    /** Assign the number of contexts to keep prepared.
+
+        Setting this to zero disables the preparation of the contexts,
+        and releases the ones prepared already.
+    */
+    void setNumPreparedContexts(int numContexts);
+
+    int getNumPreparedContexts() const;
+
+    /** Returns the number of contexts prepared and ready to be acquired. */
+    int getNumAvailableContexts() const;
+
+    /** Returns the number of contexts taken from the pool. */
+    int getNumHits() const;
+
+    /** Returns the number of contexts created on demand. */
+    int getNumMisses() const;
+
+    /** Returns the average time (in milliseconds) it takes to create a context.
+
+        This is the time saved each time a prepared context is acquired.
+    */
+    double getAverageCreationTime() const;
+
+private:
+
+    class Worker;
+
+    std::unique_ptr<Context> createContext();
+
+    mutable juce::CriticalSection lock{};
+    std::vector<std::unique_ptr<Context>> contexts{};
+    int numPreparedContexts{ 1 };
+    bool preparing{ false };
+
+    juce::WaitableEvent contextPrepared{};
+
+    int numHits{ 0 };
+    int numMisses{ 0 };
+    int numCreated{ 0 };
+    double totalCreationTime{ 0.0 };
+
+    std::unique_ptr<Worker> worker;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ContextPool)
+};
+
+} // namespace vitro
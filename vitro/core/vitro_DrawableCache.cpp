@@ -0,0 +1,66 @@
+namespace vitro {
+
+DrawableCache::DrawablePtr DrawableCache::getDrawable(Loader& loader, const juce::String& location)
+{
+    if (location.isEmpty())
+        return nullptr;
+
+    if (const auto it{ drawables.find(location) }; it != drawables.end())
+        return it->second;
+
+    DrawablePtr drawable{};
+
+    if (auto xml{ loader.loadXML(location) })
+        drawable = Drawable::createFromSVG(*xml);
+
+    // Failures are cached as well, so that a missing resource
+    // does not get reloaded by each element referring to it.
+    drawables.emplace(location, drawable);
+
+    return drawable;
+}
+
+juce::Image DrawableCache::getRasterImage(const juce::String& location,
+                                          const juce::Drawable& drawable,
+                                          const juce::AffineTransform& transform,
+                                          juce::Point<int> size,
+                                          float scale)
+{
+    const int width{ juce::roundToInt((float)size.x * scale) };
+    const int height{ juce::roundToInt((float)size.y * scale) };
+
+    if (width <= 0 || height <= 0)
+        return {};
+
+    const String key{ location + "\n" + String(width) + "x" + String(height) + "@" + String(scale)
+                      + ";" + String(transform.mat00) + "," + String(transform.mat01) + "," + String(transform.mat02)
+                      + "," + String(transform.mat10) + "," + String(transform.mat11) + "," + String(transform.mat12) };
+
+    if (const auto* image{ rasterImages.find(key) })
+        return *image;
+
+    const size_t bytes{ (size_t)width * (size_t)height * 4 };
+
+    // Do not cache the images that alone exceed the limit.
+    if (bytes > rasterImages.getLimit())
+        return {};
+
+    Image image(Image::ARGB, width, height, true);
+
+    {
+        Graphics g(image);
+        drawable.draw(g, 1.0f, transform.scaled(scale));
+    }
+
+    rasterImages.add(key, image, bytes);
+
+    return image;
+}
+
+void DrawableCache::clear()
+{
+    drawables.clear();
+    rasterImages.clear();
+}
+
+} // namespace vitro
@@ -0,0 +1,72 @@
+namespace vitro {
+
+/** Cache of the parsed SVG drawables.
+
+    SVG resources are parsed once per context and the resulting
+    drawables are shared by all the elements displaying the same source.
+    The shared drawables are never modified, an element that needs
+    to alter its drawable must work on its own copy.
+
+    Optionally the drawables can be rasterized into bitmaps, which are
+    cached per source, pixel size and scale. This allows large grids of
+    identical icons to be painted by blitting the same image.
+
+    @see Context::getDrawableCache
+*/
+class DrawableCache final
+{
+public:
+
+    using DrawablePtr = std::shared_ptr<const juce::Drawable>;
+
+    /** Default memory limit for all the rasterized drawables. */
+    constexpr static size_t defaultRasterMemoryLimit = 16 * 1024 * 1024;
+
+    DrawableCache() = default;
+
+    /** Returns the drawable parsed from the SVG resource.
+
+        The resource gets loaded and parsed on the first request only.
+        This returns nullptr if the resource cannot be loaded or parsed.
+    */
+    DrawablePtr getDrawable(Loader& loader, const juce::String& location);
+
+    /** Returns the drawable rendered into an image.
+
+        @param location     Drawable source location, which identifies the drawable.
+        @param drawable     Drawable to be rendered if not cached yet.
+        @param transform    Drawable transform in the component coordinates.
+        @param size         Component size in logical pixels.
+        @param scale        Physical pixels scale factor.
+
+        The returned image has the physical pixels size of the component.
+    */
+    juce::Image getRasterImage(const juce::String& location,
+                               const juce::Drawable& drawable,
+                               const juce::AffineTransform& transform,
+                               juce::Point<int> size,
+                               float scale);
+
+    /** Assign the memory limit in bytes for all the rasterized drawables. */
+    void setRasterMemoryLimit(size_t bytes) { rasterImages.setLimit(bytes); }
+
+    size_t getRasterMemoryLimit() const { return rasterImages.getLimit(); }
+
+    /** Returns the memory in bytes currently taken by the rasterized drawables. */
+    size_t getRasterMemoryUsage() const { return rasterImages.getUsage(); }
+
+    /** Remove all the cached drawables and images. */
+    void clear();
+
+private:
+
+    // Parsed drawables indexed by the source location.
+    std::unordered_map<juce::String, DrawablePtr, StringHash> drawables{};
+
+    // Rasterized drawables indexed by the source, transform, size and scale.
+    LRUCache<juce::String, juce::Image, StringHash> rasterImages{ defaultRasterMemoryLimit };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(DrawableCache)
+};
+
+} // namespace vitro
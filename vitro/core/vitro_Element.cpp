@@ -5,14 +5,28 @@ namespace vitro {
 //==============================================================================
 
 Element::JSObjectRef::JSObjectRef(const Element::Ptr& el)
-    : element{ el }
+    : element{ el },
+      context{ el->context },
+      classID{ el->getJSClassID() }
 {
+    context.jsObjectCreated(classID);
 }
 
 Element::JSObjectRef::~JSObjectRef()
 {
+    context.jsObjectReleased(classID);
+
+    // This gets called from the JS class finalizer, which means the JS object
+    // is being deleted and must not be referenced by the element anymore.
     if (auto el{ element.lock() }) {
-        el->context.getElementsFactory().removeStashedElement(el);
+        el->jsValue = JS_UNINITIALIZED;
+
+        // A stashed element is kept alive by its JS object only,
+        // so it gets released as soon as the object is gone.
+        if (el->stashed) {
+            el->stashed = false;
+            el->context.getElementsFactory().removeStashedElement(el);
+        }
     }
 }
 
@@ -29,21 +43,21 @@ static void copyElementAttributesFromXml(const Element::Ptr& element, const XmlE
     }
 }
 
-static Element::Ptr createElementFromXml(Context& ctx, const XmlElement& xmlElement);
+static Element::Ptr createElementFromXml(Context& ctx, const XmlElement& xmlElement, bool evaluateOnLoad = true);
 
-static void populateChildElementsFromXml(Context& ctx, const Element::Ptr& element, const XmlElement& xmlElement)
+static void populateChildElementsFromXml(Context& ctx, const Element::Ptr& element, const XmlElement& xmlElement, bool evaluateOnLoad = true)
 {
     jassert(element != nullptr);
 
     for (auto* child : xmlElement.getChildIterator()) {
-        if (auto childElement{ createElementFromXml(ctx, *child) })
+        if (auto childElement{ createElementFromXml(ctx, *child, evaluateOnLoad) })
             element->addChildElement(childElement);
         else
             DBG("Unable to create element for <" << child->getTagName() << ">");
     }
 }
 
-static Element::Ptr createElementFromXml(Context& ctx, const XmlElement& xmlElement)
+static Element::Ptr createElementFromXml(Context& ctx, const XmlElement& xmlElement, bool evaluateOnLoad)
 {
     if (xmlElement.isTextElement())
         return nullptr;
@@ -60,12 +74,13 @@ static Element::Ptr createElementFromXml(Context& ctx, const XmlElement& xmlElem
             // further but forward the current node to the element.
             element->forwardXmlElement(xmlElement);
         } else {
-            populateChildElementsFromXml(ctx, element, xmlElement);
+            populateChildElementsFromXml(ctx, element, xmlElement, evaluateOnLoad);
         }
 
         // Call element's onload script.
         // @note The element is not yet attached to its parent at this point
-        element->evaluateOnLoadScript();
+        if (evaluateOnLoad)
+            element->evaluateOnLoadScript();
     }
 
     return element;
@@ -73,6 +88,28 @@ static Element::Ptr createElementFromXml(Context& ctx, const XmlElement& xmlElem
 
 //==============================================================================
 
+Element::ScopedUpdateBatch::ScopedUpdateBatch(Element& element)
+    : root{ element.getTopLevelElement() }
+{
+    if (root != nullptr)
+        ++root->updateBatchDepth;
+}
+
+Element::ScopedUpdateBatch::~ScopedUpdateBatch()
+{
+    if (root == nullptr)
+        return;
+
+    jassert(root->updateBatchDepth > 0);
+
+    if (--root->updateBatchDepth == 0 && root->batchedUpdatePending) {
+        root->batchedUpdatePending = false;
+        root->update();
+    }
+}
+
+//==============================================================================
+
 const Identifier Element::tag("Element");
 
 JSClassID Element::jsClassID = 0;
@@ -94,11 +131,9 @@ Element::~Element()
 {
     inDestructor = true;
 
-    if (JS_VALUE_GET_TAG(jsValue) != JS_TAG_UNINITIALIZED) {
-        JS_GetClassID(jsValue, nullptr);
-
+    // @note Stashed element does not own its JS object.
+    if (hasJSValue() && !stashed)
         JS_FreeValue(context.getJSContext(), jsValue);
-    }
 };
 
 void Element::populateFromXml(const XmlElement& xmlElement)
@@ -141,6 +176,11 @@ void Element::populateFromXmlResource(const String& location)
         removeAllChildElements();
 }
 
+Element::Ptr Element::createFromXml(Context& ctx, const XmlElement& xmlElement, bool evaluateOnLoad)
+{
+    return createElementFromXml(ctx, xmlElement, evaluateOnLoad);
+}
+
 std::unique_ptr<XmlElement> Element::createXml() const
 {
     auto xml{ std::make_unique<XmlElement>(valueTree.getType().toString()) };
@@ -230,6 +270,52 @@ void Element::addChildElement(const Element::Ptr& element)
     numberOfChildrenChanged();
 }
 
+void Element::appendChildElements(const std::vector<Element::Ptr>& elements)
+{
+    const ScopedUpdateBatch batch(*this);
+
+    auto self{ shared_from_this() };
+
+    for (auto&& element : elements) {
+        if (element == nullptr)
+            continue;
+
+        element->parent = self;
+        children.push_back(element);
+
+        valueTree.appendChild(element->valueTree, nullptr);
+
+        element->reconcileElementTree();
+        element->unstash();
+    }
+
+    numberOfChildrenChanged();
+}
+
+Element::Ptr Element::cloneElement(bool deep)
+{
+    auto clone{ context.getElementsFactory().createElement(getTag()) };
+
+    if (clone == nullptr)
+        return nullptr;
+
+    clone->cloneFrom(*this);
+
+    if (deep && !hasInnerXml() && !children.empty()) {
+        std::vector<Element::Ptr> clonedChildren{};
+        clonedChildren.reserve(children.size());
+
+        for (auto&& child : children) {
+            if (auto clonedChild{ child->cloneElement(true) })
+                clonedChildren.push_back(clonedChild);
+        }
+
+        clone->appendChildElements(clonedChildren);
+    }
+
+    return clone;
+}
+
 void Element::removeChildElement(const Element::Ptr& element)
 {
     jassert(element != nullptr);
@@ -277,26 +363,13 @@ void Element::removeAllChildElements()
 
 void Element::replaceChildElements(const std::vector<Element::Ptr>& newChildren)
 {
-    std::vector<bool> retainedChildren(children.size());
-
-    for (size_t i = 0; i < children.size(); ++i) {
-        bool retain{ false };
-        auto& child{ children.at(i) };
+    std::unordered_set<const Element*> retainedChildren{};
 
-        for (auto& newChild : newChildren) {
-            if (child == newChild) {
-                retain = true;
-                break;
-            }
-        }
-
-        retainedChildren[i] = retain;
-    }
-
-    for (size_t i = 0; i < children.size(); ++i) {
-        auto& child{ children.at(i) };
+    for (auto& newChild : newChildren)
+        retainedChildren.insert(newChild.get());
 
-        if (!retainedChildren[i]) {
+    for (auto& child : children) {
+        if (retainedChildren.count(child.get()) == 0) {
             child->elementIsAboutToBeRemoved();
             child->notifyChildrenAboutToBeRemoved();
             child->stash();
@@ -351,6 +424,16 @@ bool Element::hasAttribute (const Identifier& name) const
     return valueTree.hasProperty(name);
 }
 
+void Element::removeAttribute(const Identifier& name)
+{
+    if (isStyledElement() && name == attr::style) {
+        if (auto* styledElement{ dynamic_cast<StyledElement*>(this) })
+            styledElement->setStyleAttribute({});
+    }
+
+    valueTree.removeProperty(name, nullptr);
+}
+
 void Element::updateElementIfNeeded()
 {
     if (updatePending) {
@@ -398,21 +481,49 @@ void Element::registerJSPrototype(JSContext* jsCtx, JSValue prototype)
     registerJSMethod(jsCtx, prototype, "appendChild",     &js_appendChild);
     registerJSMethod(jsCtx, prototype, "removeChild",     &js_removeChild);
     registerJSMethod(jsCtx, prototype, "replaceChildren", &js_replaceChildren);
+    registerJSMethod(jsCtx, prototype, "cloneNode",       &js_cloneNode);
 }
 
 void Element::stash()
 {
+    // Elements without a JS object cannot be referenced from the script,
+    // so there is no need to keep them alive.
+    if (stashed || !hasJSValue())
+        return;
+
+    stashed = true;
     context.getElementsFactory().stashElement(shared_from_this());
+
+    // While stashed the element is owned by the stash, and it is the JS object
+    // that keeps the stash entry alive. We release our own reference here so that
+    // the object can be finalized once the script no longer references it.
+    // @note This may finalize the JS object immediately, which will also
+    //       remove this element from the stash.
+    const JSValue value{ jsValue };
+    JS_FreeValue(context.getJSContext(), value);
 }
 
 void Element::unstash()
 {
+    if (!stashed)
+        return;
+
+    stashed = false;
+
+    // Take back the ownership of the JS object.
+    JS_DupValue(context.getJSContext(), jsValue);
+
     context.getElementsFactory().removeStashedElement(shared_from_this());
 }
 
 JSValue Element::duplicateJSValue()
 {
-    return JS_DupValue(context.getJSContext(), jsValue);
+    return JS_DupValue(context.getJSContext(), getJSValue());
+}
+
+bool Element::hasJSValue() const
+{
+    return JS_VALUE_GET_TAG(jsValue) != JS_TAG_UNINITIALIZED;
 }
 
 int Element::getJSValueRefCount() const
@@ -442,7 +553,22 @@ void Element::setUpdateHook(const HookFunc& func)
 
 void Element::initialize()
 {
-    initJSValue();
+}
+
+void Element::cloneFrom(const Element& other)
+{
+    for (int i = 0; i < other.valueTree.getNumProperties(); ++i) {
+        const auto name{ other.valueTree.getPropertyName(i) };
+
+        // Interaction state is not cloned
+        if (name == attr::hover || name == attr::active)
+            continue;
+
+        valueTree.setPropertyExcludingListener(this, name, other.valueTree.getProperty(name), nullptr);
+        changedAttributes.insert(name);
+    }
+
+    updatePending = true;
 }
 
 void Element::update()
@@ -490,31 +616,143 @@ void Element::forEachChild(const std::function<void(const Element::Ptr&)>& func,
 
 void Element::evaluateAttributeScript(const Identifier& attr, const juce::var& data)
 {
-    const auto val{ getAttribute(attr) };
+    auto* jsCtx{ context.getJSContext() };
 
-    if (val.isVoid())
+    // The handler may replace its own attribute, so we keep a reference while calling it.
+    const auto func{ JS_DupValue(jsCtx, getAttributeFunction(attr)) };
+
+    if (JS_IsUndefined(func))
         return;
 
-    auto* jsCtx{ context.getJSContext() };
+    JSValue arg{ data.isVoid() ? JS_UNDEFINED : js::varToJSValue(jsCtx, data) };
+    auto res{ JS_Call(jsCtx, func, getJSValue(), data.isVoid() ? 0 : 1, &arg) };
+
+    if (JS_IsException(res)) {
+        DBG("Exception thrown when evaluating " << attr.toString() << " of <" << getTag().toString() << ">");
+        jsDumpError(jsCtx, res);
+    }
+
+    JS_FreeValue(jsCtx, res);
+    JS_FreeValue(jsCtx, arg);
+    JS_FreeValue(jsCtx, func);
+}
+
+// Function evaluating a script attribute as a global script, which returns its
+// completion value. The data holds the script source and its file name.
+static JSValue js_evalAttributeScript(JSContext* ctx, JSValueConst self, int argc, JSValueConst* arg, int, JSValue* data)
+{
+    size_t length{};
+    const auto* script{ JS_ToCStringLen(ctx, &length, data[0]) };
+
+    if (script == nullptr)
+        return JS_EXCEPTION;
+
+    const auto* fileName{ JS_ToCString(ctx, data[1]) };
+
+    // The event data is exposed as a global for the duration of the call.
+    auto global{ JS_GetGlobalObject(ctx) };
+    const auto eventAtom{ JS_NewAtom(ctx, "event") };
+    const bool hadEvent{ JS_HasProperty(ctx, global, eventAtom) > 0 };
+    auto prevEvent{ hadEvent ? JS_GetProperty(ctx, global, eventAtom) : JS_UNDEFINED };
+
+    JS_SetProperty(ctx, global, eventAtom, argc > 0 ? JS_DupValue(ctx, arg[0]) : JS_UNDEFINED);
+
+    auto res{ JS_EvalThis(ctx, self, script, length, fileName != nullptr ? fileName : "", JS_EVAL_TYPE_GLOBAL) };
+
+    if (hadEvent)
+        JS_SetProperty(ctx, global, eventAtom, prevEvent);
+    else
+        JS_DeleteProperty(ctx, global, eventAtom, 0);
+
+    JS_FreeAtom(ctx, eventAtom);
+    JS_FreeValue(ctx, global);
+    JS_FreeCString(ctx, fileName);
+    JS_FreeCString(ctx, script);
+
+    return res;
+}
+
+JSValue Element::getAttributeFunction(const Identifier& attr, bool completionValue)
+{
+    const auto& val{ getAttribute(attr) };
+
+    if (val.isVoid())
+        return JS_UNDEFINED;
 
     if (val.isObject()) {
-        if (auto* func{ dynamic_cast<js::Function*>(val.getObject()) }) {
-            if (data.isVoid())
-                func->callThis(jsValue);
-            else
-                func->callThis(jsValue, data);
+        if (auto* func{ dynamic_cast<js::Function*>(val.getObject()) })
+            return func->getJSValue();
+
+        return JS_UNDEFINED;
+    }
+
+    const auto source{ val.toString() };
+    auto& compiled{ compiledScripts[attr] };
+
+    if (compiled.source != source || compiled.completionValue != completionValue) {
+        compiled.source = source;
+        compiled.completionValue = completionValue;
+        compiled.function = var();
+
+        auto* jsCtx{ context.getJSContext() };
+
+        const auto fileName{ "<" + getTag().toString() + " " + attr.toString() + ">" };
+
+        const auto compile = [&](const String& code) {
+            const auto utf8{ code.toUTF8() };
+            return JS_Eval(jsCtx, utf8, utf8.sizeInBytes() - 1, fileName.toRawUTF8(), JS_EVAL_TYPE_GLOBAL);
+        };
+
+        // A single expression script returns its value (like onacceptdrop does),
+        // otherwise the script becomes the body of a function.
+        auto func{ compile("(function(event) { return (" + source + "\n); })") };
+
+        if (JS_IsException(func) && completionValue) {
+            JS_FreeValue(jsCtx, JS_GetException(jsCtx));
+
+            // A function cannot return the completion value of the statements,
+            // and the engine cannot run a compiled global script with the element
+            // as `this`, so the script gets evaluated on each call. It is only
+            // compiled here to report the syntax errors once.
+            func = JS_Eval(jsCtx, source.toRawUTF8(), source.getNumBytesAsUTF8(), fileName.toRawUTF8(),
+                           JS_EVAL_TYPE_GLOBAL | JS_EVAL_FLAG_COMPILE_ONLY);
+
+            if (!JS_IsException(func)) {
+                JS_FreeValue(jsCtx, func);
+
+                JSValue data[]{ JS_NewString(jsCtx, source.toRawUTF8()), JS_NewString(jsCtx, fileName.toRawUTF8()) };
+                func = JS_NewCFunctionData(jsCtx, js_evalAttributeScript, 1, 0, 2, data);
+
+                JS_FreeValue(jsCtx, data[0]);
+                JS_FreeValue(jsCtx, data[1]);
+            }
+        } else if (JS_IsException(func)) {
+            JS_FreeValue(jsCtx, JS_GetException(jsCtx));
+            func = compile("(function(event) {\n" + source + "\n})");
         }
-    } else {
-        auto res{ context.evalThis(jsValue, val.toString()) };
 
-        if (JS_IsException(res)) {
-            DBG("Exception thrown when evaluating " << attr.toString() << " of <" << getTag().toString() << ">");
-            jsDumpError(jsCtx, res);
+        if (JS_IsException(func)) {
+            DBG("Exception thrown when compiling " << attr.toString() << " of <" << getTag().toString() << ">");
+            jsDumpError(jsCtx, func);
+        } else if (JS_IsFunction(jsCtx, func)) {
+            compiled.function = var(new js::Function(jsCtx, func));
         }
 
-        if (JS_VALUE_GET_TAG(res) != JS_TAG_UNDEFINED)
-            JS_FreeValue(jsCtx, res);
+        JS_FreeValue(jsCtx, func);
     }
+
+    if (auto* func{ dynamic_cast<js::Function*>(compiled.function.getObject()) })
+        return func->getJSValue();
+
+    return JS_UNDEFINED;
+}
+
+JSValue Element::getJSValue()
+{
+    if (!hasJSValue())
+        initJSValue();
+
+    return hasJSValue() ? jsValue : JS_UNDEFINED;
 }
 
 void Element::registerConstructor(JSContext* jsCtx, JSValue proto, StringRef name, JSCFunction func, int numArgs)
@@ -559,22 +797,32 @@ void Element::registerJSProperty(JSContext* jsCtx, JSValue proto, StringRef name
 
 void Element::initJSValue()
 {
-    jsValue = JS_NewObjectClass(context.getJSContext(), getJSClassID());
-    JS_SetOpaque(jsValue, new JSObjectRef(shared_from_this()));
+    // JS object can only be created for an element owned by a shared pointer,
+    // which is not the case while the element is being constructed or deleted.
+    if (auto self{ weak_from_this().lock() }) {
+        jsValue = JS_NewObjectClass(context.getJSContext(), getJSClassID());
+        JS_SetOpaque(jsValue, new JSObjectRef(self));
+    }
 }
 
 void Element::triggerUpdate()
 {
     updatePending = true;
 
-    if (auto root{ getTopLevelElement() })
-        root->update();
+    if (auto root{ getTopLevelElement() }) {
+        if (root->updateBatchDepth > 0)
+            root->batchedUpdatePending = true;
+        else
+            root->update();
+    }
 }
 
 void Element::valueTreePropertyChanged(ValueTree&, const Identifier& changedAttr)
 {
     changedAttributes.insert(changedAttr);
+    compiledScripts.erase(changedAttr);
 
+    attributeChanged(changedAttr);
     triggerUpdate();
 }
 
@@ -706,9 +954,7 @@ JSValue Element::js_getAttribute(JSContext* ctx, JSValueConst self, int argc, JS
         return JS_ThrowSyntaxError(ctx, "getAttribute expects a single argument - attribute's name");
 
     if (auto element{ Context::getJSNativeObject<Element>(self) }) {
-        const auto* str{ JS_ToCString(ctx, arg[0]) };
-        const auto attrName{ String::fromUTF8(str) };
-        JS_FreeCString(ctx, str);
+        const auto attrName{ element->context.getAtomCache().getIdentifier(ctx, arg[0]) };
         const juce::var& val{ element->getAttribute(attrName) };
         return js::varToJSValue(ctx, val);
     }
@@ -722,9 +968,11 @@ JSValue Element::js_setAttribute(JSContext* ctx, JSValueConst self, int argc, JS
         return JS_ThrowSyntaxError(ctx, "setAttribute expects two arguments: attribute's name and value");
 
     if (auto element{ Context::getJSNativeObject<Element>(self) }) {
-        const auto* str{ JS_ToCString(ctx, arg[0]) };
-        const auto attrName{ String::fromUTF8(str) };
-        JS_FreeCString(ctx, str);
+        const auto attrName{ element->context.getAtomCache().getIdentifier(ctx, arg[0]) };
+
+        if (!attrName.isValid())
+            return JS_ThrowTypeError(ctx, "setAttribute expects a non-empty attribute name");
+
         const auto val{ js::JSValueToVar(ctx, arg[1]) };
         element->setAttribute(attrName, val);
     }
@@ -738,9 +986,7 @@ JSValue Element::js_hasAttribute(JSContext* ctx, JSValueConst self, int argc, JS
         return JS_ThrowSyntaxError(ctx, "hasAttribute expects a single argument - attribute name");
 
     if (auto element{ Context::getJSNativeObject<Element>(self) }) {
-        const auto* str{ JS_ToCString(ctx, arg[0]) };
-        const auto name{ String::fromUTF8(str) };
-        JS_FreeCString(ctx, str);
+        const auto name{ element->context.getAtomCache().getIdentifier(ctx, arg[0]) };
 
         if (element->hasAttribute(name))
             return JS_TRUE;
@@ -876,4 +1122,22 @@ JSValue Element::js_replaceChildren([[maybe_unused]] JSContext* ctx, JSValueCons
     return JS_UNDEFINED;
 }
 
+JSValue Element::js_cloneNode(JSContext* ctx, JSValueConst self, int argc, JSValueConst* arg)
+{
+    const bool deep{ argc > 0 && JS_ToBool(ctx, arg[0]) > 0 };
+
+    if (auto element{ Context::getJSNativeObject<Element>(self) }) {
+        if (auto clone{ element->cloneElement(deep) }) {
+            // The JS object must exist before stashing the element.
+            auto jsClone{ clone->duplicateJSValue() };
+            clone->stash();
+            return jsClone;
+        }
+
+        return JS_NULL;
+    }
+
+    return JS_UNDEFINED;
+}
+
 } // namespace vitro
@@ -33,10 +33,33 @@ public:
     struct JSObjectRef final
     {
         Element::WeakPtr element{};
+        Context& context;
+        JSClassID classID;
         JSObjectRef(const Element::Ptr& el);
         ~JSObjectRef();
     };
 
+    /** Defer the elements tree update while in scope.
+
+        All the updates triggered while the batch is active are merged
+        into a single one, which is triggered when the outermost batch
+        goes out of scope.
+
+        @note The batch is associated with the top-level element at the
+              moment of creation. The element must not be re-parented
+              while the batch is active.
+    */
+    class ScopedUpdateBatch final
+    {
+    public:
+        explicit ScopedUpdateBatch(Element& element);
+        ~ScopedUpdateBatch();
+
+    private:
+        Element::Ptr root;
+        JUCE_DECLARE_NON_COPYABLE(ScopedUpdateBatch)
+    };
+
     using HookFunc = std::function<void(const Element::Ptr&)>;
 
     const static juce::Identifier tag;  // <Element>
@@ -86,6 +109,17 @@ public:
 
     void populateFromXmlResource(const juce::String& location);
 
+    /** Create an element tree from XML.
+
+        This creates a new element (and all its children) from
+        the given XML. The created element is not attached to any parent.
+        If evaluateOnLoad is set, the onload scripts will be evaluated
+        on the created elements.
+
+        @return Created element or nullptr if the element cannot be created.
+    */
+    static Element::Ptr createFromXml(Context& ctx, const juce::XmlElement& xmlElement, bool evaluateOnLoad = true);
+
     /** Returns XML representation of this element's value tree.
 
         @note This method does not copy element attributes that cannot
@@ -138,6 +172,30 @@ public:
     */
     void addChildElement(const Element::Ptr& element);
 
+    /** Add multiple child elements.
+
+        This is equivalent to adding the elements one by one,
+        but the elements tree update will be triggered only once.
+
+        @see addChildElement
+    */
+    void appendChildElements(const std::vector<Element::Ptr>& elements);
+
+    /** Create a copy of this element.
+
+        The attributes and the resolved style properties of this element
+        are copied in bulk, so that the clone does not need to go through
+        the full style resolution on its first update.
+
+        @note The elements that consume their inner XML manage their
+              children themselves, so their children are never cloned.
+
+        @param deep If true the children will be cloned recursively.
+        @return Cloned element (not attached to any parent), or nullptr
+                if the element cannot be created.
+    */
+    Element::Ptr cloneElement(bool deep);
+
     /** Remove child element.
 
         @param element Pointer to element to be removed.
@@ -182,6 +240,12 @@ public:
     */
     bool hasAttribute(const juce::Identifier& name) const;
 
+    /** Remove an attribute from this element.
+
+        This triggers the element update, same as setting an attribute.
+    */
+    void removeAttribute(const juce::Identifier& name);
+
     /** Perform an update on this element.
 
         This method calls the @ref update() on this element if it's
@@ -211,16 +275,37 @@ public:
     // properties and methods exposed.
     static void registerJSPrototype(JSContext* jsCtx, JSValue prototype);
 
-    /** Store this element in factory's stash. */
+    /** Store this element in factory's stash.
+
+        A stashed element is kept alive until its JS object gets finalized
+        by the script engine, or until it gets unstashed.
+
+        @note Elements that have no JS object are not stashed, since they
+              cannot be referenced from the script.
+    */
     void stash();
 
     /** Remove this element from factory's stash. */
     void unstash();
 
-    /** Returns a duplicate of the internal JS value. */
+    /** Tells whether this element is currently stashed. */
+    bool isStashed() const { return stashed; }
+
+    /** Returns a duplicate of the internal JS value.
+
+        The JS object representing this element is created on first access,
+        and then kept for the entire lifetime of the element.
+    */
     JSValue duplicateJSValue();
 
-    /** Returns the JS object reference counter. */
+    /** Tells whether the JS object for this element has been created. */
+    bool hasJSValue() const;
+
+    /** Returns the JS object reference counter.
+
+        @return JS object reference count, or -1 if the JS object
+                has not been created yet.
+    */
     int getJSValueRefCount() const;
 
     /** Evaluate onload attribute script.
@@ -238,12 +323,32 @@ protected:
     /** Perform element initialization.
 
         This method is called by the factory immediately after being constructed.
-        The default implementation initializes the internal JSValue of the element.
+
+        @note The JS object of the element is not created here, but on first access.
+              @see getJSValue
 
         @note Overriding methods must make sure to call initialize of the parent class.
      */
     virtual void initialize();
 
+    /** Copy this element's state from another element.
+
+        This method is called on a newly created element when cloning.
+        The attributes are copied without triggering the update.
+        Derived elements may override this method to copy their internal
+        state that cannot be restored from the attributes.
+
+        @note Overriding methods must call cloneFrom of the parent class.
+        @see cloneElement
+    */
+    virtual void cloneFrom(const Element& other);
+
+    /** Notify this element that its attribute has changed.
+
+        This is called before the update gets triggered.
+    */
+    virtual void attributeChanged(const juce::Identifier&) {}
+
     /** Update this element.
 
         Elements will override this method to perform an update of the inner state.
@@ -268,6 +373,9 @@ protected:
     */
     std::pair<bool, const juce::var&> getAttributeChanged(const juce::Identifier& attr) const;
 
+    /** Returns the attributes changed since the last update. */
+    const std::set<juce::Identifier>& getChangedAttributes() const { return changedAttributes; }
+
     /** Notify all children of this element that they are about to be deleted. */
     void notifyChildrenAboutToBeRemoved();
 
@@ -298,9 +406,47 @@ protected:
     /** Children elements iterator. */
     void forEachChild(const std::function<void(const Element::Ptr&)>& func, bool recursive = true);
 
-    /** Evaluate script or function stored as element's attribute. */
+    /** Evaluate script or function stored as element's attribute.
+
+        The data, if provided, is passed to the function as its argument.
+        @see getAttributeFunction
+    */
     void evaluateAttributeScript(const juce::Identifier& attr, const juce::var& data = {});
 
+    /** Returns the function stored as element's attribute.
+
+        A script string attribute gets compiled into a function taking
+        a single `event` argument on the first call. The compiled function
+        is then reused until the attribute changes.
+
+        A single expression script returns its value. Any other script becomes
+        the function body, unless its completion value is requested, in which
+        case the function evaluates it as a global script on each call (with
+        `event` exposed as a global) and returns the completion value.
+
+        This returns JS_UNDEFINED if the attribute is neither a function
+        nor a script, or if the script fails to compile. The returned value
+        is not duplicated and must not be freed by the caller.
+
+        @param attr             Attribute name.
+        @param completionValue  Whether the result of the script is used (like
+                                onacceptdrop's), which must then be its completion value.
+    */
+    JSValue getAttributeFunction(const juce::Identifier& attr, bool completionValue = false);
+
+    /** Schedule the elements tree update.
+
+        This flags the element for update and notifies the top-level element.
+    */
+    void triggerUpdate();
+
+    /** Returns the internal JS value.
+
+        The JS object will be created if it does not exist yet.
+        The returned value is not duplicated and must not be freed by the caller.
+    */
+    JSValue getJSValue();
+
     // The following are helper functions to register
     // element's JavaScript prototype object.
     using JSGetter = JSValue(*)(JSContext*, JSValueConst);
@@ -322,7 +468,10 @@ protected:
     /** Array of this element's direct children. */
     std::vector<Element::Ptr> children{};
 
-    /** JavaScript object associated with this element. */
+    /** JavaScript object associated with this element.
+
+        @note This value is created lazily, use getJSValue() to access it.
+    */
     JSValue jsValue{ JS_UNINITIALIZED };
 
     /** This flag tells element is in destruction phase. */
@@ -338,8 +487,13 @@ private:
     // Initialize the internal JS object
     void initJSValue();
 
-    // Schedule the elements tree update
-    void triggerUpdate();
+    // Script attribute compiled into a function.
+    struct CompiledScript final
+    {
+        juce::String source{};
+        bool completionValue{};
+        juce::var function{};   // js::Function, void if compilation failed
+    };
 
     // juce::ValueTree::Listener
     void valueTreePropertyChanged(juce::ValueTree&, const juce::Identifier&) override;
@@ -366,6 +520,18 @@ private:
     static JSValue js_appendChild(JSContext* ctx, JSValueConst self, int argc, JSValueConst* arg);
     static JSValue js_removeChild(JSContext* ctx, JSValueConst self, int argc, JSValueConst* arg);
     static JSValue js_replaceChildren(JSContext* ctx, JSValueConst self, int argc, JSValueConst* arg);
+    static JSValue js_cloneNode(JSContext* ctx, JSValueConst self, int argc, JSValueConst* arg);
+
+    /// This flag indicates that the element is stashed. A stashed element
+    /// does not own its JS object, but rather the object owns the element.
+    /// @see stash
+    bool stashed{};
+
+    /// Number of active update batches on this (top-level) element
+    /// and whether an update has been triggered during the batch.
+    /// @see ScopedUpdateBatch
+    int updateBatchDepth{};
+    bool batchedUpdatePending{};
 
     /// This flag indicates that the element must be updated.
     /// @see updateElementIfNeeded
@@ -375,6 +541,9 @@ private:
     // once the element is updated.
     std::set<juce::Identifier> changedAttributes{};
 
+    // Script attributes compiled into functions.
+    std::map<juce::Identifier, CompiledScript> compiledScripts{};
+
     // Function to be executed on element update.
     // This is used to inject additional behavior which cannot be
     // achieved by inheriting from the Element class.
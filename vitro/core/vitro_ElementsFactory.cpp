@@ -18,6 +18,7 @@ void ElementsFactory::registerDefaultElements()
 
     registerElement<vitro::Script>();
     registerElement<vitro::Style>();
+    registerElement<vitro::Template>();
     registerElement<vitro::View>();
     registerElement<vitro::Panel>();
     registerElement<vitro::Label>();
@@ -28,6 +29,7 @@ void ElementsFactory::registerDefaultElements()
     registerElement<vitro::Svg>();
     registerElement<vitro::TextEditor>();
     registerElement<vitro::ScrollArea>();
+    registerElement<vitro::VirtualList>();
     registerElement<vitro::ComboBox>();
     registerElement<vitro::MenuBar>();
     registerElement<vitro::MenuItem>();
@@ -79,34 +81,30 @@ Element::Ptr ElementsFactory::createElement(const Identifier& tag)
 
 void ElementsFactory::stashElement(const Element::Ptr& element)
 {
-    if (std::find(stashedElements.begin(), stashedElements.end(), element) == stashedElements.end()) {
-        stashedElements.push_back(element);
-    }
+    jassert(element != nullptr);
+    stashedElements.emplace(element.get(), element);
 }
 
 void ElementsFactory::removeStashedElement(const Element::Ptr& element)
 {
-    stashedElements.erase(std::remove(stashedElements.begin(), stashedElements.end(), element), stashedElements.end());
+    jassert(element != nullptr);
+    stashedElements.erase(element.get());
 }
 
 void ElementsFactory::clearStashedElements()
 {
-    stashedElements.clear();
-}
+    // Stashed elements do not own their JS objects. We unstash them first
+    // so that the objects get released along with the elements.
+    std::vector<Element::Ptr> elements{};
+    elements.reserve(stashedElements.size());
 
-void ElementsFactory::clearUnreferencedStashedElements()
-{
-    auto it{ stashedElements.begin() };
+    for (auto&& [ptr, element] : stashedElements)
+        elements.push_back(element);
 
-    while (it != stashedElements.end()) {
-        auto& ptr{ *it };
+    for (auto&& element : elements)
+        element->unstash();
 
-        if (ptr.use_count() == 1 && ptr->getJSValueRefCount() == 1) {
-            it = stashedElements.erase(it);
-        } else {
-            ++it;
-        }
-    }
+    stashedElements.clear();
 }
 
 } // namespace vitro
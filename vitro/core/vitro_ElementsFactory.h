@@ -63,19 +63,20 @@ public:
         The factory maintains a collection of shared pointers for the
         elements that might be in transition between script and native context.
         Until finalized (attached to the elements tree or garbage collected by
-        the scripting engine) the epement's pointer must be kept alive in order
-        to prevent memory access problems. Elements that live on stash only
-        will eventually be collected and deleted.
+        the scripting engine) the element's pointer must be kept alive in order
+        to prevent memory access problems.
 
-        @see clearUnreferencedStashedElements
+        Stashed elements are released when their JS objects get finalized.
+
+        @see Element::stash
     */
     void stashElement(const Element::Ptr& element);
 
     /** Remove element from the stash.
 
-        This method is normally called when the element gets attached to its parent.
-        At this point the parent becomes the owner of the element, which can now
-        be removed from the stash.
+        This method is normally called when the element gets attached to its parent,
+        or when its JS object gets finalized. In the first case the parent becomes
+        the owner of the element, which can now be removed from the stash.
     */
     void removeStashedElement(const Element::Ptr& element);
 
@@ -86,13 +87,8 @@ public:
     */
     void clearStashedElements();
 
-    /** Remove all elements that are referenced by the stash only.
-
-        This method perform "garbage collection" of the stashed elements.
-        All the elements that live in the stash only and are not referenced
-        from the script context will be deleted.
-    */
-    void clearUnreferencedStashedElements();
+    /** Returns number of currently stashed elements. */
+    size_t getNumStashedElements() const { return stashedElements.size(); }
 
 private:
 
@@ -101,7 +97,7 @@ private:
     using CreateFunc = std::function<Element::Ptr()>;
     std::map<juce::Identifier, CreateFunc> creators{};
 
-    std::vector<Element::Ptr> stashedElements{};
+    std::unordered_map<const Element*, Element::Ptr> stashedElements{};
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ElementsFactory)
 };
@@ -0,0 +1,209 @@
+namespace vitro {
+
+namespace {
+    // Smallest variant is 1/256 of the source.
+    constexpr int kMaxVariantLevel = 8;
+}
+
+juce::Image ImageCache::get(const juce::String& location, bool keepSource)
+{
+    const ScopedLock scopedLock(lock);
+
+    if (const auto it{ entries.find(location) }; it != entries.end()) {
+        it->second.keepSource = it->second.keepSource || keepSource;
+
+        if (const auto v{ it->second.variants.find(0) }; v != it->second.variants.end()) {
+            v->second.lastUsed = ++useCounter;
+            return v->second.image;
+        }
+    }
+
+    return {};
+}
+
+void ImageCache::add(const juce::String& location, const juce::Image& image, bool keepSource)
+{
+    if (!image.isValid())
+        return;
+
+    const ScopedLock scopedLock(lock);
+
+    auto& entry{ entries[location] };
+
+    // A new source invalidates all the previous variants.
+    if (entry.sourceWidth != image.getWidth() || entry.sourceHeight != image.getHeight()) {
+        for (const auto& [level, variant] : entry.variants)
+            memoryUsage -= getImageSize(variant.image);
+
+        entry.variants.clear();
+        entry.sourceWidth = image.getWidth();
+        entry.sourceHeight = image.getHeight();
+    }
+
+    entry.keepSource = entry.keepSource || keepSource;
+
+    store(location, entry, 0, image);
+}
+
+juce::Image ImageCache::getVariant(const juce::String& location, const juce::Image& source, int width, int height)
+{
+    const ScopedLock scopedLock(lock);
+
+    auto it{ entries.find(location) };
+
+    if (it == entries.end()) {
+        if (!source.isValid())
+            return {};
+
+        it = entries.emplace(location, Entry{ source.getWidth(), source.getHeight() }).first;
+    }
+
+    auto& entry{ it->second };
+
+    int level{ 0 };
+
+    while (level < kMaxVariantLevel
+           && (entry.sourceWidth >> (level + 1)) >= juce::jmax(1, width)
+           && (entry.sourceHeight >> (level + 1)) >= juce::jmax(1, height)) {
+        ++level;
+    }
+
+    if (const auto v{ entry.variants.find(level) }; v != entry.variants.end()) {
+        v->second.lastUsed = ++useCounter;
+        return v->second.image;
+    }
+
+    // Downscale from the nearest larger variant available.
+    Image base{ source };
+
+    for (auto v{ entry.variants.rbegin() }; v != entry.variants.rend(); ++v) {
+        if (v->first < level) {
+            base = v->second.image;
+            break;
+        }
+    }
+
+    if (!base.isValid()) {
+        if (entry.variants.empty())
+            entries.erase(it);
+
+        return {};
+    }
+
+    const auto variant{ base.rescaled(juce::jmax(1, entry.sourceWidth >> level),
+                                      juce::jmax(1, entry.sourceHeight >> level),
+                                      Graphics::highResamplingQuality) };
+
+    store(location, entry, level, variant);
+
+    // The full resolution image is not drawn by anyone, so only the variants are kept.
+    // The entry is looked up again since storing the variant may have removed it.
+    if (it = entries.find(location); level > 0 && it != entries.end() && !it->second.keepSource) {
+        auto& variants{ it->second.variants };
+
+        if (const auto v{ variants.find(0) }; v != variants.end() && variants.count(level) != 0) {
+            memoryUsage -= getImageSize(v->second.image);
+            variants.erase(v);
+        }
+    }
+
+    return variant;
+}
+
+juce::Image ImageCache::getLargestVariant(const juce::String& location)
+{
+    const ScopedLock scopedLock(lock);
+
+    if (const auto it{ entries.find(location) }; it != entries.end() && !it->second.variants.empty()) {
+        auto& variant{ it->second.variants.begin()->second };
+        variant.lastUsed = ++useCounter;
+        return variant.image;
+    }
+
+    return {};
+}
+
+void ImageCache::setMemoryLimit(size_t bytes)
+{
+    const ScopedLock scopedLock(lock);
+
+    memoryLimit = bytes;
+    evict(nullptr);
+}
+
+void ImageCache::clear()
+{
+    const ScopedLock scopedLock(lock);
+
+    entries.clear();
+    memoryUsage = 0;
+}
+
+size_t ImageCache::getImageSize(const juce::Image& image)
+{
+    const size_t pixelSize{ image.getFormat() == Image::SingleChannel ? 1u
+                          : image.getFormat() == Image::RGB ? 3u : 4u };
+
+    return (size_t)image.getWidth() * (size_t)image.getHeight() * pixelSize;
+}
+
+void ImageCache::store(const juce::String& location, Entry& entry, int level, const juce::Image& image)
+{
+    const auto size{ getImageSize(image) };
+
+    if (const auto v{ entry.variants.find(level) }; v != entry.variants.end()) {
+        memoryUsage -= getImageSize(v->second.image);
+        entry.variants.erase(v);
+    }
+
+    if (size > memoryLimit) {
+        if (entry.variants.empty())
+            entries.erase(location);
+
+        return;
+    }
+
+    entry.variants[level] = { image, ++useCounter };
+    memoryUsage += size;
+
+    evict(&image);
+}
+
+void ImageCache::evict(const juce::Image* imageToKeep)
+{
+    while (memoryUsage > memoryLimit) {
+        Entry* lruEntry{ nullptr };
+        int lruLevel{ -1 };
+        juce::uint64 lruUsed{ std::numeric_limits<juce::uint64>::max() };
+
+        for (auto& [location, entry] : entries) {
+            for (const auto& [level, variant] : entry.variants) {
+                if (imageToKeep != nullptr && variant.image == *imageToKeep)
+                    continue;
+
+                if (variant.lastUsed < lruUsed) {
+                    lruEntry = &entry;
+                    lruLevel = level;
+                    lruUsed = variant.lastUsed;
+                }
+            }
+        }
+
+        if (lruEntry == nullptr)
+            break;
+
+        const auto v{ lruEntry->variants.find(lruLevel) };
+        memoryUsage -= getImageSize(v->second.image);
+        lruEntry->variants.erase(v);
+    }
+
+    // Remove the entries with no variants left.
+    for (auto it{ entries.begin() }; it != entries.end();) {
+        if (it->second.variants.empty())
+            it = entries.erase(it);
+        else
+            ++it;
+    }
+}
+
+} // namespace vitro
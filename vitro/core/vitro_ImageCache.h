@@ -0,0 +1,121 @@
+namespace vitro {
+
+/** Cache of the loaded images.
+
+    The cache keeps the decoded images along with their downscaled variants.
+    Each variant is half the size of the previous one, so that an image displayed
+    smaller than its source can be rescaled from the nearest variant instead
+    of the full resolution image.
+
+    Once a smaller variant has been derived, the full resolution image is
+    released unless it has been requested by a consumer drawing it as is
+    (such as a tiled background or a texture). It gets loaded again if a
+    larger variant is needed later on.
+
+    The cache keeps track of the memory taken by all the images and variants.
+    When the memory limit is reached the least recently used ones get released.
+    An image that does not fit into the limit alone is not cached.
+
+    Each context has its own cache, owned by the context's loader.
+    This class is thread-safe.
+
+    @see Loader::getImageCache
+*/
+class ImageCache final
+{
+public:
+
+    /** Default memory limit for all the cached images. */
+    constexpr static size_t defaultMemoryLimit = 128 * 1024 * 1024;
+
+    ImageCache() = default;
+
+    /** Returns the full resolution image, or an invalid image if not cached.
+
+        @param location     Image location.
+        @param keepSource   Keep the full resolution image cached after
+                            the smaller variants have been derived.
+    */
+    juce::Image get(const juce::String& location, bool keepSource = false);
+
+    /** Add a full resolution image to the cache.
+
+        @param location     Image location.
+        @param image        Full resolution image.
+        @param keepSource   Keep the full resolution image cached after
+                            the smaller variants have been derived.
+    */
+    void add(const juce::String& location, const juce::Image& image, bool keepSource = false);
+
+    /** Returns the smallest image variant covering the given size.
+
+        The variant is created from the nearest larger cached variant. If there
+        is none, the source image is used, which must then be a full resolution
+        image of the location. This returns an invalid image if the variant
+        cannot be created.
+
+        @param location     Image location.
+        @param source       Full resolution image, may be invalid.
+        @param width        Requested width in physical pixels.
+        @param height       Requested height in physical pixels.
+    */
+    juce::Image getVariant(const juce::String& location, const juce::Image& source, int width, int height);
+
+    /** Returns the largest cached variant, or an invalid image if none.
+
+        This can be drawn upscaled while the full resolution image,
+        needed for a larger variant, is being loaded again.
+    */
+    juce::Image getLargestVariant(const juce::String& location);
+
+    /** Assign the memory limit in bytes for all the cached images. */
+    void setMemoryLimit(size_t bytes);
+
+    size_t getMemoryLimit() const { return memoryLimit; }
+
+    /** Returns the memory in bytes currently taken by the cached images. */
+    size_t getMemoryUsage() const { return memoryUsage; }
+
+    /** Remove all the images from the cache. */
+    void clear();
+
+private:
+
+    struct Variant final
+    {
+        juce::Image image{};
+        juce::uint64 lastUsed{};
+    };
+
+    struct Entry final
+    {
+        int sourceWidth{};
+        int sourceHeight{};
+
+        // Whether the full resolution image is drawn as is by some consumer.
+        bool keepSource{};
+
+        // Cached variants, where the level n is the image downscaled 2^n times.
+        std::map<int, Variant> variants{};
+    };
+
+    static size_t getImageSize(const juce::Image& image);
+
+    void store(const juce::String& location, Entry& entry, int level, const juce::Image& image);
+
+    // Release the least recently used variants until the usage fits the limit.
+    void evict(const juce::Image* imageToKeep);
+
+    std::unordered_map<juce::String, Entry, StringHash> entries{};
+
+    juce::CriticalSection lock{};
+
+    size_t memoryLimit{ defaultMemoryLimit };
+    size_t memoryUsage{};
+
+    juce::uint64 useCounter{};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ImageCache)
+};
+
+} // namespace vitro
@@ -0,0 +1,117 @@
+namespace vitro {
+
+class Element;
+
+/** Runtime performance counters.
+
+    The counters are collected by the context and can be used to monitor
+    the cost of the UI updates. All the counters are accumulated
+    until explicitly reset.
+
+    @see Context::getInstrumentation
+*/
+struct Instrumentation final
+{
+    /** Layout engine counters. */
+    struct Layout final
+    {
+        /// Number of layout nodes that had their style pushed to Yoga.
+        juce::int64 nodesRebuilt{};
+
+        /// Number of layout nodes that received new layout results.
+        juce::int64 nodesRecalculated{};
+
+        /// Number of components repositioned to their new layout bounds.
+        juce::int64 componentsMoved{};
+
+        /// Number of the layout computations performed.
+        juce::int64 passesComputed{};
+
+        /// Number of the layout computations skipped since nothing has changed.
+        juce::int64 passesSkipped{};
+
+        /// Number of the off-thread layout computations superseded before being computed or applied.
+        juce::int64 passesDropped{};
+    };
+
+    /** Layout engine statistics of a single element.
+
+        This is collected only when VITRO_ENABLE_LAYOUT_PROFILER is enabled.
+        A high number of layout or measure passes relative to the number
+        of the layout computations indicates a costly container.
+    */
+    struct ElementLayout final
+    {
+        /// Number of the layout pass reasons reported by the layout engine.
+        constexpr static size_t numReasons = 8;
+
+        std::weak_ptr<Element> element{};
+
+        /// Element tag and id, so that it can be identified after deletion.
+        juce::String description{};
+
+        /// Number of the layout passes actually computed.
+        juce::int64 layouts{};
+
+        /// Number of the measure passes actually computed.
+        juce::int64 measures{};
+
+        /// Number of the layout passes served from the cache.
+        juce::int64 cachedLayouts{};
+
+        /// Number of the measure passes served from the cache.
+        juce::int64 cachedMeasures{};
+
+        /// Number of the element's measure function calls.
+        juce::int64 measureCallbacks{};
+
+        /// Measure function calls per layout pass reason.
+        std::array<juce::int64, numReasons> measureCallbackReasons{};
+
+        juce::int64 getCacheHits() const { return cachedLayouts + cachedMeasures; }
+        juce::int64 getCacheMisses() const { return layouts + measures; }
+
+        /** Returns the layout pass reason name as reported by the layout engine. */
+        static const char* getReasonName(size_t reason)
+        {
+            constexpr static std::array<const char*, numReasons> names {
+                "initial", "abs_layout", "stretch", "multiline_stretch",
+                "flex_layout", "measure", "abs_measure", "flex_measure"
+            };
+
+            return reason < numReasons ? names[reason] : "unknown";
+        }
+    };
+
+    Layout layout{};
+
+    /// Per-element layout statistics.
+    std::unordered_map<const Element*, ElementLayout> elementLayouts{};
+
+    /** Returns the elements statistics sorted by the number of computed layout passes.
+
+        @param maxCount Maximum number of the elements to return.
+    */
+    std::vector<const ElementLayout*> getMostExpensiveElementLayouts(size_t maxCount) const
+    {
+        std::vector<const ElementLayout*> result{};
+        result.reserve(elementLayouts.size());
+
+        for (const auto& [key, stats] : elementLayouts)
+            result.push_back(&stats);
+
+        std::sort(result.begin(), result.end(), [](const ElementLayout* a, const ElementLayout* b) {
+            return a->getCacheMisses() > b->getCacheMisses();
+        });
+
+        if (result.size() > maxCount)
+            result.resize(maxCount);
+
+        return result;
+    }
+
+    /** Reset all the counters. */
+    void reset() { *this = Instrumentation{}; }
+};
+
+} // namespace vitro
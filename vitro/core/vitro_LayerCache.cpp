@@ -0,0 +1,173 @@
+namespace vitro {
+
+/** Cached component image with memory accounting.
+
+    This follows juce's standard cached component image, but the image
+    memory is accounted by the layers cache.
+*/
+class LayerCache::Layer final : public juce::CachedComponentImage
+{
+public:
+
+    Layer(LayerCache& layerCache, juce::Component& component)
+        : cache{ layerCache },
+          owner{ component }
+    {
+        cache.layers.push_back(this);
+    }
+
+    ~Layer() override
+    {
+        releaseResources();
+
+        auto& layers{ cache.layers };
+        layers.erase(std::remove(layers.begin(), layers.end(), this), layers.end());
+    }
+
+    // juce::CachedComponentImage
+    void paint(juce::Graphics& g) override
+    {
+        const auto scale{ g.getInternalContext().getPhysicalPixelScaleFactor() };
+        const auto compBounds{ owner.getLocalBounds() };
+        const auto imageBounds{ (compBounds.toFloat() * scale).getSmallestIntegerContainer() };
+
+        if (!image.isValid() || image.getBounds() != imageBounds) {
+            releaseResources();
+
+            const auto width{ juce::jmax(1, imageBounds.getWidth()) };
+            const auto height{ juce::jmax(1, imageBounds.getHeight()) };
+
+            if (!cache.reserve(*this, (size_t)width * (size_t)height * 4)) {
+                // The layer does not fit into the memory limit.
+                owner.paintEntireComponent(g, false);
+                return;
+            }
+
+            image = juce::Image(owner.isOpaque() ? juce::Image::RGB : juce::Image::ARGB, width, height, !owner.isOpaque());
+        }
+
+        lastUsed = ++cache.useCounter;
+
+        if (!validArea.containsRectangle(compBounds)) {
+            juce::Graphics imageGraphics(image);
+            auto& lg{ imageGraphics.getInternalContext() };
+
+            lg.addTransform(juce::AffineTransform::scale(scale));
+
+            for (const auto& rect : validArea)
+                lg.excludeClipRectangle(rect);
+
+            if (!owner.isOpaque()) {
+                lg.setFill(juce::Colours::transparentBlack);
+                lg.fillRect(compBounds, true);
+                lg.setFill(juce::Colours::black);
+            }
+
+            owner.paintEntireComponent(imageGraphics, true);
+        }
+
+        validArea = compBounds;
+
+        g.setColour(juce::Colours::black.withAlpha(owner.getAlpha()));
+        g.drawImageTransformed(image, juce::AffineTransform::scale((float)compBounds.getWidth() / (float)imageBounds.getWidth(),
+                                                                   (float)compBounds.getHeight() / (float)imageBounds.getHeight()),
+                               false);
+    }
+
+    bool invalidateAll() override
+    {
+        validArea.clear();
+        return true;
+    }
+
+    bool invalidate(const juce::Rectangle<int>& area) override
+    {
+        validArea.subtract(area);
+        return true;
+    }
+
+    void releaseResources() override
+    {
+        if (bytes > 0)
+            cache.release(*this);
+
+        image = {};
+        validArea.clear();
+    }
+
+    LayerCache& cache;
+    juce::Component& owner;
+
+    juce::Image image{};
+    juce::RectangleList<int> validArea{};
+
+    // Image memory accounted by the cache.
+    size_t bytes{};
+
+    juce::uint64 lastUsed{};
+};
+
+//==============================================================================
+
+LayerCache::LayerCache() = default;
+
+LayerCache::~LayerCache()
+{
+    // Layers are owned by the components, which must be deleted first.
+    jassert(layers.empty());
+}
+
+std::unique_ptr<juce::CachedComponentImage> LayerCache::createLayer(juce::Component& component)
+{
+    return std::make_unique<Layer>(*this, component);
+}
+
+void LayerCache::setMemoryLimit(size_t newLimit)
+{
+    memoryLimit = newLimit;
+    evict(0, nullptr);
+}
+
+bool LayerCache::reserve(Layer& layer, size_t bytes)
+{
+    jassert(layer.bytes == 0);
+
+    if (bytes > memoryLimit)
+        return false;
+
+    evict(bytes, &layer);
+
+    layer.bytes = bytes;
+    memoryUsage += bytes;
+
+    return true;
+}
+
+void LayerCache::release(Layer& layer)
+{
+    jassert(memoryUsage >= layer.bytes);
+
+    memoryUsage -= layer.bytes;
+    layer.bytes = 0;
+}
+
+void LayerCache::evict(size_t bytesToFit, const Layer* layerToKeep)
+{
+    while (memoryUsage + bytesToFit > memoryLimit) {
+        Layer* leastRecentlyUsed{ nullptr };
+
+        for (auto* layer : layers) {
+            if (layer != layerToKeep && layer->bytes > 0
+                && (leastRecentlyUsed == nullptr || layer->lastUsed < leastRecentlyUsed->lastUsed))
+                leastRecentlyUsed = layer;
+        }
+
+        if (leastRecentlyUsed == nullptr)
+            break;
+
+        // Released layer gets rendered again next time it is painted.
+        leastRecentlyUsed->releaseResources();
+    }
+}
+
+} // namespace vitro
@@ -0,0 +1,64 @@
+namespace vitro {
+
+/** Cache of the rasterized component layers.
+
+    A component element with the `layer: cached` style property gets
+    its subtree rendered into an offscreen image, which is then reused
+    until the component or any of its children gets repainted or resized.
+
+    The cache keeps track of the memory taken by all the layer images.
+    When the memory limit is reached the least recently painted layers
+    get released. A layer that does not fit into the limit alone is
+    painted directly, without caching.
+
+    @see Context::getLayerCache
+*/
+class LayerCache final
+{
+public:
+
+    /** Default memory limit for all the cached layers. */
+    constexpr static size_t defaultMemoryLimit = 64 * 1024 * 1024;
+
+    LayerCache();
+    ~LayerCache();
+
+    /** Create a cached image for the component.
+
+        The returned object should be passed to juce::Component::setCachedComponentImage.
+    */
+    std::unique_ptr<juce::CachedComponentImage> createLayer(juce::Component& component);
+
+    /** Assign the memory limit in bytes for all the cached layers. */
+    void setMemoryLimit(size_t bytes);
+
+    size_t getMemoryLimit() const { return memoryLimit; }
+
+    /** Returns the memory in bytes currently taken by the layer images. */
+    size_t getMemoryUsage() const { return memoryUsage; }
+
+    /** Returns the number of the existing layers. */
+    size_t getNumLayers() const { return layers.size(); }
+
+private:
+
+    class Layer;
+
+    // Make room for the layer image, releasing other layers if needed.
+    bool reserve(Layer& layer, size_t bytes);
+    void release(Layer& layer);
+
+    // Release the least recently used layers until the usage fits the limit.
+    void evict(size_t bytesToFit, const Layer* layerToKeep);
+
+    std::vector<Layer*> layers{};
+
+    size_t memoryLimit{ defaultMemoryLimit };
+    size_t memoryUsage{};
+
+    juce::uint64 useCounter{};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LayerCache)
+};
+
+} // namespace vitro
@@ -133,6 +133,30 @@ const static std::map<String, YGWrap> wrapValues {
     { YGWrapToString(YGWrapWrapReverse), YGWrapWrapReverse }
 };
 
+/** Returns all the style properties that affect the layout. */
+static const std::set<Identifier>& getLayoutStyleProperties()
+{
+    const static std::set<Identifier> properties{ [] {
+        std::set<Identifier> names {
+            direction, flex_direction, justify_content, align_items, align_content, align_self,
+            position, display, flex_wrap, overflow,
+            flex, flex_grow, flex_shrink, aspect_ratio, flex_basis,
+            width, height, min_width, min_height, max_width, max_height,
+            left, right, top, bottom
+        };
+
+        for (const auto& [edgeName, edgeEnum] : edgeValues) {
+            names.insert(Identifier(margin_ + edgeName));
+            names.insert(Identifier(padding_ + edgeName));
+            names.insert(Identifier(border_ + edgeName));
+        }
+
+        return names;
+    }() };
+
+    return properties;
+}
+
 } // namespace yoga
 
 //==============================================================================
@@ -152,6 +176,261 @@ struct DefaultConfigDeleter final
 
 const static DefaultConfigDeleter defaultConfigDeleter;
 
+/** Apply new layout results to the components.
+
+    This walks the nodes that received a new layout, resets their flag
+    and moves the corresponding components to their new bounds.
+    Yoga does not visit the subtrees which layout has not changed,
+    so we don't need to go any deeper when a node has no new layout.
+*/
+static void applyNewLayout(YGNodeRef node, Instrumentation::Layout& counters)
+{
+    if (!YGNodeGetHasNewLayout(node))
+        return;
+
+    YGNodeSetHasNewLayout(node, false);
+    ++counters.nodesRecalculated;
+
+    if (auto* layoutElement{ reinterpret_cast<LayoutElement*>(YGNodeGetContext(node)) }) {
+        if (layoutElement->isComponentElement()) {
+            if (auto* componentElement{ dynamic_cast<ComponentElement*>(layoutElement) }) {
+                if (componentElement->updateComponentBoundsToLayoutNode())
+                    ++counters.componentsMoved;
+            }
+        }
+    }
+
+    const uint32_t numChildren{ YGNodeGetChildCount(node) };
+
+    for (uint32_t i = 0; i < numChildren; ++i)
+        applyNewLayout(YGNodeGetChild(node, i), counters);
+}
+
+static constexpr float unconstrainedSize{ std::numeric_limits<float>::infinity() };
+
+/** Fit the measured content size into the size given by the layout engine. */
+static YGSize constrainMeasuredSize(juce::Point<float> size, float width, YGMeasureMode widthMode, float height, YGMeasureMode heightMode)
+{
+    const auto constrain = [](float measured, float available, YGMeasureMode mode) {
+        if (mode == YGMeasureModeExactly)
+            return available;
+
+        if (mode == YGMeasureModeAtMost)
+            return juce::jmin(measured, available);
+
+        return measured;
+    };
+
+    return { constrain(size.x, width, widthMode), constrain(size.y, height, heightMode) };
+}
+
+/** Mark the nodes as laid out.
+
+    Dirty flag propagates up to the root, so the clean nodes
+    have no dirty descendants and need not to be visited.
+*/
+static void markLayoutClean(YGNodeRef node)
+{
+    if (!YGNodeIsDirty(node))
+        return;
+
+    node->setDirty(false);
+
+    const uint32_t numChildren{ YGNodeGetChildCount(node) };
+
+    for (uint32_t i = 0; i < numChildren; ++i)
+        markLayoutClean(YGNodeGetChild(node, i));
+}
+
+#if VITRO_ENABLE_LAYOUT_PROFILER
+
+static_assert(Instrumentation::ElementLayout::numReasons == static_cast<size_t>(facebook::yoga::LayoutPassReason::COUNT),
+              "Layout pass reasons do not match the layout engine");
+
+/** Collect the layout engine events into the per-element statistics.
+
+    The layout computations pass the context instrumentation as the layout
+    context, while the off-thread snapshot computations pass none,
+    so that their events get ignored here.
+*/
+static void collectLayoutEvent(const YGNode& node, facebook::yoga::Event::Type type, facebook::yoga::Event::Data data)
+{
+    using facebook::yoga::Event;
+    using facebook::yoga::LayoutType;
+
+    const auto getStats = [&node](void* layoutContext) -> Instrumentation::ElementLayout* {
+        auto* instrumentation{ static_cast<Instrumentation*>(layoutContext) };
+        auto* element{ static_cast<LayoutElement*>(node.getContext()) };
+
+        if (instrumentation == nullptr || element == nullptr)
+            return nullptr;
+
+        auto& stats{ instrumentation->elementLayouts[element] };
+
+        // Element address may belong to a deleted element.
+        if (stats.element.expired()) {
+            stats = {};
+            stats.element = element->weak_from_this();
+            stats.description = element->getTag().toString();
+
+            if (const auto& id{ element->getAttribute(attr::id) }; !id.isVoid())
+                stats.description << "#" << id.toString();
+        }
+
+        return &stats;
+    };
+
+    if (type == Event::NodeLayout) {
+        const auto& eventData{ data.get<Event::NodeLayout>() };
+
+        if (auto* stats{ getStats(eventData.layoutContext) }) {
+            switch (eventData.layoutType) {
+                case LayoutType::kLayout:        ++stats->layouts;        break;
+                case LayoutType::kMeasure:       ++stats->measures;       break;
+                case LayoutType::kCachedLayout:  ++stats->cachedLayouts;  break;
+                case LayoutType::kCachedMeasure: ++stats->cachedMeasures; break;
+            }
+        }
+    } else if (type == Event::MeasureCallbackEnd) {
+        const auto& eventData{ data.get<Event::MeasureCallbackEnd>() };
+
+        if (auto* stats{ getStats(eventData.layoutContext) }) {
+            ++stats->measureCallbacks;
+
+            const auto reason{ static_cast<size_t>(eventData.reason) };
+
+            if (reason < stats->measureCallbackReasons.size())
+                ++stats->measureCallbackReasons[reason];
+        }
+    }
+}
+
+static void subscribeToLayoutEvents()
+{
+    // Subscription is global and gets shared by all the contexts.
+    [[maybe_unused]] const static bool subscribed{ [] {
+        facebook::yoga::Event::subscribe(&collectLayoutEvent);
+        return true;
+    }() };
+}
+
+#endif // VITRO_ENABLE_LAYOUT_PROFILER
+
+//==============================================================================
+
+struct LayoutElement::Snapshot::Impl final
+{
+    struct Node final
+    {
+        std::weak_ptr<Element> element{};
+        LayoutElement* layoutElement{};
+
+        // Element's own layout node. This must be accessed on the message thread only.
+        YGNodeRef source{};
+
+        // Detached copy of the layout node.
+        YGNodeRef node{};
+
+        // Content size of a measured element.
+        juce::Point<float> contentSize{};
+    };
+
+    // Captured nodes, the first one being the root.
+    std::vector<Node> nodes{};
+
+    float width{};
+    float height{};
+
+    ~Impl()
+    {
+        if (!nodes.empty())
+            YGNodeFreeRecursive(nodes.front().node);
+    }
+
+    YGNodeRef capture(YGNodeRef source)
+    {
+        auto* element{ reinterpret_cast<LayoutElement*>(YGNodeGetContext(source)) };
+        jassert(element != nullptr);
+
+        Node entry{ element->weak_from_this(), element, source, YGNodeNew() };
+        YGNodeCopyStyle(entry.node, source);
+
+        if (YGNodeHasMeasureFunc(source)) {
+            // Elements cannot be accessed from the worker thread, so we measure them
+            // in advance for their definite size, which the synchronous layout would
+            // pass to the measure function, or for the unconstrained size otherwise.
+            const auto width{ getDefiniteContentSize(YGNodeStyleGetWidth(source), YGNodeLayoutGetWidth(source),
+                                                     getEdgeInset(source, YGEdgeLeft) + getEdgeInset(source, YGEdgeRight)) };
+            const auto height{ getDefiniteContentSize(YGNodeStyleGetHeight(source), YGNodeLayoutGetHeight(source),
+                                                      getEdgeInset(source, YGEdgeTop) + getEdgeInset(source, YGEdgeBottom)) };
+
+            entry.contentSize = element->measureContent(width, height);
+            YGNodeSetMeasureFunc(entry.node, &measure);
+        }
+
+        auto* copy{ entry.node };
+        nodes.push_back(std::move(entry));
+
+        const uint32_t numChildren{ YGNodeGetChildCount(source) };
+
+        for (uint32_t i = 0; i < numChildren; ++i)
+            YGNodeInsertChild(copy, capture(YGNodeGetChild(source, i)), i);
+
+        return copy;
+    }
+
+    // Padding and border of the node edge, where only the point values are resolved.
+    static float getEdgeInset(YGNodeConstRef node, YGEdge edge)
+    {
+        auto padding{ YGNodeStyleGetPadding(node, edge) };
+
+        if (padding.unit == YGUnitUndefined)
+            padding = YGNodeStyleGetPadding(node, YGEdgeAll);
+
+        auto border{ YGNodeStyleGetBorder(node, edge) };
+
+        if (std::isnan(border))
+            border = YGNodeStyleGetBorder(node, YGEdgeAll);
+
+        return (padding.unit == YGUnitPoint ? padding.value : 0.0f) + (std::isnan(border) ? 0.0f : border);
+    }
+
+    // Content size of a node with a definite size, the relative sizes
+    // are taken from the last computed layout.
+    static float getDefiniteContentSize(YGValue size, float laidOutSize, float insets)
+    {
+        float outerSize{ unconstrainedSize };
+
+        if (size.unit == YGUnitPoint)
+            outerSize = size.value;
+        else if (size.unit == YGUnitPercent && laidOutSize > 0.0f)
+            outerSize = laidOutSize;
+
+        return std::isfinite(outerSize) ? juce::jmax(0.0f, outerSize - insets) : unconstrainedSize;
+    }
+
+    static YGSize measure(YGNodeRef node, float width, YGMeasureMode widthMode, float height, YGMeasureMode heightMode)
+    {
+        const auto* entry{ static_cast<const Node*>(YGNodeGetContext(node)) };
+        jassert(entry != nullptr);
+
+        return constrainMeasuredSize(entry->contentSize, width, widthMode, height, heightMode);
+    }
+};
+
+LayoutElement::Snapshot::Snapshot()
+    : d{ std::make_unique<Impl>() }
+{
+}
+
+LayoutElement::Snapshot::~Snapshot() = default;
+
+void LayoutElement::Snapshot::calculate()
+{
+    if (!d->nodes.empty())
+        YGNodeCalculateLayout(d->nodes.front().node, d->width, d->height, YGDirectionInherit);
+}
+
 //==============================================================================
 
 JSClassID LayoutElement::jsClassID = 0;
@@ -159,13 +438,18 @@ JSClassID LayoutElement::jsClassID = 0;
 struct LayoutElement::Layout final
 {
     LayoutElement& self;
-    std::unique_ptr<YGNode, void(*)(const YGNodeRef)> nodePtr;
+    LayoutNodePool& pool;
     YGNodeRef node{};
 
+    // Available size of the last layout computation
+    // (used on the root node only).
+    float availableWidth{ std::numeric_limits<float>::quiet_NaN() };
+    float availableHeight{ std::numeric_limits<float>::quiet_NaN() };
+
     Layout(LayoutElement& element)
         : self{ element },
-          nodePtr(YGNodeNew(), YGNodeFree),
-          node{ nodePtr.get() }
+          pool{ element.context.getLayoutNodePool() },
+          node{ pool.allocate() }
     {
         YGNodeSetContext(node, &element);
     }
@@ -174,6 +458,20 @@ struct LayoutElement::Layout final
     {
         if (auto* owner{ node->getOwner() })
             YGNodeRemoveChild(owner, node);
+
+        pool.release(node);
+    }
+
+    // Yoga measure function forwarding to the element.
+    static YGSize measure(YGNodeRef node, float width, YGMeasureMode widthMode, float height, YGMeasureMode heightMode)
+    {
+        auto* element{ reinterpret_cast<LayoutElement*>(YGNodeGetContext(node)) };
+        jassert(element != nullptr);
+
+        const auto size{ element->measureContent(widthMode  == YGMeasureModeUndefined ? unconstrainedSize : width,
+                                                 heightMode == YGMeasureModeUndefined ? unconstrainedSize : height) };
+
+        return constrainMeasuredSize(size, width, widthMode, height, heightMode);
     }
 
     template <typename T>
@@ -348,6 +646,52 @@ struct LayoutElement::Layout final
         return changed;
     }
 
+    bool assignPointValue(float value,
+                          YGValue(*getter)(YGNodeConstRef),
+                          void(*assign)(YGNodeRef, float))
+    {
+        const auto currentValue{ getter(node) };
+
+        if (currentValue.unit != YGUnitPoint || currentValue.value != value) {
+            assign(node, value);
+            return true;
+        }
+
+        return false;
+    }
+
+    bool assignPointValue(float value,
+                          YGEdge edgeEnum,
+                          YGValue(*getter)(YGNodeConstRef, YGEdge),
+                          void(*assign)(YGNodeRef, YGEdge, float))
+    {
+        const auto currentValue{ getter(node, edgeEnum) };
+
+        if (currentValue.unit != YGUnitPoint || currentValue.value != value) {
+            assign(node, edgeEnum, value);
+            return true;
+        }
+
+        return false;
+    }
+
+    bool assignBoundsOverride(const juce::Rectangle<float>& bounds)
+    {
+        bool changed{ false };
+
+        if (YGNodeStyleGetPositionType(node) != YGPositionTypeAbsolute) {
+            YGNodeStyleSetPositionType(node, YGPositionTypeAbsolute);
+            changed = true;
+        }
+
+        changed = assignPointValue(bounds.getX(),      YGEdgeLeft, YGNodeStyleGetPosition, YGNodeStyleSetPosition) || changed;
+        changed = assignPointValue(bounds.getY(),      YGEdgeTop,  YGNodeStyleGetPosition, YGNodeStyleSetPosition) || changed;
+        changed = assignPointValue(bounds.getWidth(),  YGNodeStyleGetWidth,  YGNodeStyleSetWidth)  || changed;
+        changed = assignPointValue(bounds.getHeight(), YGNodeStyleGetHeight, YGNodeStyleSetHeight) || changed;
+
+        return changed;
+    }
+
     bool rebuild()
     {
         bool changed{ false };
@@ -358,7 +702,6 @@ struct LayoutElement::Layout final
         changed = assignProperty(yoga::align_items,     yoga::alignValues,         YGNodeStyleSetAlignItems,     YGNodeStyleGetAlignItems)     || changed;
         changed = assignProperty(yoga::align_content,   yoga::alignValues,         YGNodeStyleSetAlignContent,   YGNodeStyleGetAlignContent)   || changed;
         changed = assignProperty(yoga::align_self,      yoga::alignValues,         YGNodeStyleSetAlignSelf,      YGNodeStyleGetAlignSelf)      || changed;
-        changed = assignProperty(yoga::position,        yoga::positionTypeValues,  YGNodeStyleSetPositionType,   YGNodeStyleGetPositionType)   || changed;
         changed = assignProperty(yoga::flex_wrap,       yoga::wrapValues,          YGNodeStyleSetFlexWrap,       YGNodeStyleGetFlexWrap)       || changed;
         changed = assignProperty(yoga::overflow,        yoga::overflowValues,      YGNodeStyleSetOverflow,       YGNodeStyleGetOverflow)       || changed;
         changed = assignProperty(yoga::display,         yoga::displayValues,       YGNodeStyleSetDisplay,        YGNodeStyleGetDisplay)        || changed;
@@ -369,14 +712,20 @@ struct LayoutElement::Layout final
         changed = assignFloatProperty(yoga::aspect_ratio, YGNodeStyleSetAspectRatio, YGNodeStyleGetAspectRatio) || changed;
 
         changed = assignFloatProperty(yoga::flex_basis,   YGNodeStyleSetFlexBasis, YGNodeStyleSetFlexBasisPercent, YGNodeStyleGetFlexBasis) || changed;
-        changed = assignFloatProperty(yoga::width,        YGNodeStyleSetWidth,     YGNodeStyleSetWidthPercent,     YGNodeStyleGetWidth)     || changed;
-        changed = assignFloatProperty(yoga::height,       YGNodeStyleSetHeight,    YGNodeStyleSetHeightPercent,    YGNodeStyleGetHeight)    || changed;
         changed = assignFloatProperty(yoga::min_width,    YGNodeStyleSetMinWidth,  YGNodeStyleSetMinWidthPercent,  YGNodeStyleGetMinWidth)  || changed;
         changed = assignFloatProperty(yoga::min_height,   YGNodeStyleSetMinHeight, YGNodeStyleSetMinHeightPercent, YGNodeStyleGetMinHeight) || changed;
         changed = assignFloatProperty(yoga::max_width,    YGNodeStyleSetMaxWidth,  YGNodeStyleSetMaxWidthPercent,  YGNodeStyleGetMaxWidth)  || changed;
         changed = assignFloatProperty(yoga::max_height,   YGNodeStyleSetMaxHeight, YGNodeStyleSetMaxHeightPercent, YGNodeStyleGetMaxHeight) || changed;
 
-        changed = assignEdgeFloatProperty(YGNodeStyleSetPosition, YGNodeStyleSetPositionPercent, YGNodeStyleGetPosition) || changed;
+        if (self.boundsOverride.has_value()) {
+            // Element's placement is controlled explicitly
+            changed = assignBoundsOverride(*self.boundsOverride) || changed;
+        } else {
+            changed = assignProperty(yoga::position, yoga::positionTypeValues, YGNodeStyleSetPositionType, YGNodeStyleGetPositionType) || changed;
+            changed = assignFloatProperty(yoga::width,  YGNodeStyleSetWidth,  YGNodeStyleSetWidthPercent,  YGNodeStyleGetWidth)  || changed;
+            changed = assignFloatProperty(yoga::height, YGNodeStyleSetHeight, YGNodeStyleSetHeightPercent, YGNodeStyleGetHeight) || changed;
+            changed = assignEdgeFloatProperty(YGNodeStyleSetPosition, YGNodeStyleSetPositionPercent, YGNodeStyleGetPosition) || changed;
+        }
 
         changed = assignEdgeFloatProperty(yoga::margin_left,   YGEdgeLeft,   YGNodeStyleSetMargin, YGNodeStyleSetMarginPercent, YGNodeStyleGetMargin) || changed;
         changed = assignEdgeFloatProperty(yoga::margin_right,  YGEdgeRight,  YGNodeStyleSetMargin, YGNodeStyleSetMarginPercent, YGNodeStyleGetMargin) || changed;
@@ -406,43 +755,29 @@ LayoutElement::LayoutElement(const Identifier& elementTag, Context& ctx)
     : StyledElement(elementTag, ctx),
       layout{ std::make_unique<Layout>(*this) }
 {
-    registerStyleProperty(yoga::direction);
-    registerStyleProperty(yoga::flex_direction);
-    registerStyleProperty(yoga::justify_content);
-    registerStyleProperty(yoga::align_items);
-    registerStyleProperty(yoga::align_content);
-    registerStyleProperty(yoga::align_self);
-    registerStyleProperty(yoga::position);
-    registerStyleProperty(yoga::display);
-    registerStyleProperty(yoga::flex_wrap);
-    registerStyleProperty(yoga::overflow);
-
-    registerStyleProperty(yoga::flex);
-    registerStyleProperty(yoga::flex_grow);
-    registerStyleProperty(yoga::flex_shrink);
-    registerStyleProperty(yoga::aspect_ratio);
-    registerStyleProperty(yoga::flex_basis);
-    registerStyleProperty(yoga::width);
-    registerStyleProperty(yoga::height);
-    registerStyleProperty(yoga::min_width);
-    registerStyleProperty(yoga::min_height);
-    registerStyleProperty(yoga::max_width);
-    registerStyleProperty(yoga::max_height);
-
-    registerStyleProperty(yoga::left);
-    registerStyleProperty(yoga::right);
-    registerStyleProperty(yoga::top);
-    registerStyleProperty(yoga::bottom);
-
-    for (auto it = yoga::edgeValues.cbegin(); it != yoga::edgeValues.cend(); ++it) {
-        registerStyleProperty(Identifier(yoga::margin_ + it->first));
-        registerStyleProperty(Identifier(yoga::padding_ + it->first));
-        registerStyleProperty(Identifier(yoga::border_ + it->first));
-    }
+    for (const auto& name : yoga::getLayoutStyleProperties())
+        registerStyleProperty(name);
 }
 
 LayoutElement::~LayoutElement() = default;
 
+void LayoutElement::update()
+{
+    StyledElement::update();
+
+    for (const auto& name : getChangedStyleProperties()) {
+        if (isLayoutStyleProperty(name)) {
+            layoutStylePending = true;
+            break;
+        }
+    }
+}
+
+bool LayoutElement::isLayoutStyleProperty(const Identifier& name)
+{
+    return yoga::getLayoutStyleProperties().count(name) != 0;
+}
+
 juce::Rectangle<float> LayoutElement::getLayoutElementBounds() const
 {
     return {
@@ -467,13 +802,38 @@ LayoutElement::Ptr LayoutElement::getParentLayoutElement()
     return nullptr;
 }
 
-bool LayoutElement::updateLayout()
+void LayoutElement::setLayoutBoundsOverride(const juce::Rectangle<float>& bounds)
 {
-    bool changed{ layout->rebuild() };
+    if (boundsOverride.has_value() && *boundsOverride == bounds)
+        return;
+
+    boundsOverride = bounds;
+
+    // Bounds override is applied on the next layout update.
+    layoutStylePending = true;
+    triggerUpdate();
+}
 
+bool LayoutElement::updateLayout()
+{
     jassert(layout != nullptr);
     jassert(layout->node != nullptr);
 
+    bool changed{ false };
+
+    // Style is pushed into the layout node only when the layout style properties change.
+    if (layoutStylePending) {
+        layoutStylePending = false;
+        changed = layout->rebuild();
+        ++context.getInstrumentation().layout.nodesRebuilt;
+    }
+
+    // Measure function could have been dropped when adding children.
+    if (intrinsicSize && !YGNodeHasMeasureFunc(layout->node) && YGNodeGetChildCount(layout->node) == 0) {
+        YGNodeSetMeasureFunc(layout->node, &Layout::measure);
+        changed = true;
+    }
+
     const uint32_t numChildren{ YGNodeGetChildCount(layout->node) };
 
     for (uint32_t i = 0; i < numChildren; ++i) {
@@ -495,20 +855,115 @@ bool LayoutElement::updateLayout()
 
 void LayoutElement::recalculateLayout(float width, float height)
 {
+    auto& counters{ context.getInstrumentation().layout };
+
+    // Yoga propagates the dirty flag up to the root whenever a node style or
+    // the nodes tree changes. A clean tree of the same size needs no computation.
+    if (!YGNodeIsDirty(layout->node) && width == layout->availableWidth && height == layout->availableHeight) {
+        ++counters.passesSkipped;
+        return;
+    }
+
+    layout->availableWidth = width;
+    layout->availableHeight = height;
+
+#if VITRO_ENABLE_LAYOUT_PROFILER
+    subscribeToLayoutEvents();
+    YGNodeCalculateLayoutWithContext(layout->node, width, height, YGDirectionInherit, &context.getInstrumentation());
+#else
     YGNodeCalculateLayout(layout->node, width, height, YGDirectionInherit);
+#endif
+
+    ++counters.passesComputed;
 
-    if (isComponentElement()) {
-        if (auto* componentElement{ dynamic_cast<ComponentElement*>(this) })
-            componentElement->updateComponentBoundsToLayoutNode();
+    // Only the nodes visited by Yoga may have their bounds changed.
+    applyNewLayout(layout->node, counters);
+}
+
+std::unique_ptr<LayoutElement::Snapshot> LayoutElement::createLayoutSnapshot(float width, float height)
+{
+    if (!YGNodeIsDirty(layout->node) && width == layout->availableWidth && height == layout->availableHeight) {
+        ++context.getInstrumentation().layout.passesSkipped;
+        return nullptr;
     }
 
+    layout->availableWidth = width;
+    layout->availableHeight = height;
+
+    std::unique_ptr<Snapshot> snapshot{ new Snapshot() };
+    snapshot->d->width = width;
+    snapshot->d->height = height;
+    snapshot->d->capture(layout->node);
+
+    // Nodes pointers are stable once all the nodes have been captured.
+    for (auto& entry : snapshot->d->nodes)
+        YGNodeSetContext(entry.node, &entry);
+
+    // From now on the layout nodes are considered laid out, so that
+    // any change made before the snapshot gets applied will make it stale.
+    markLayoutClean(layout->node);
+
+    return snapshot;
+}
+
+void LayoutElement::applyLayoutSnapshot(const Snapshot& snapshot)
+{
+    auto& counters{ context.getInstrumentation().layout };
+    ++counters.passesComputed;
+
+    for (const auto& entry : snapshot.d->nodes) {
+        // Element may have been deleted while the layout was computed.
+        if (entry.element.expired())
+            continue;
+
+        const auto& computed{ entry.node->getLayout() };
+        const auto& current{ entry.source->getLayout() };
 
-    forEachChild([](const Element::Ptr& child) {
-        if (child->isComponentElement()) {
-            if (auto componentElement{ std::dynamic_pointer_cast<ComponentElement>(child) })
-                componentElement->updateComponentBoundsToLayoutNode();
+        if (computed.position == current.position && computed.dimensions == current.dimensions)
+            continue;
+
+        ++counters.nodesRecalculated;
+
+        for (int i = 0; i < (int)computed.position.size(); ++i)
+            entry.source->setLayoutPosition(computed.position[(size_t)i], i);
+
+        for (int i = 0; i < (int)computed.dimensions.size(); ++i)
+            entry.source->setLayoutDimension(computed.dimensions[(size_t)i], i);
+
+        if (entry.layoutElement->isComponentElement()) {
+            if (auto* componentElement{ dynamic_cast<ComponentElement*>(entry.layoutElement) }) {
+                if (componentElement->updateComponentBoundsToLayoutNode())
+                    ++counters.componentsMoved;
+            }
         }
-    }, true);
+    }
+}
+
+void LayoutElement::invalidateLayout()
+{
+    YGNodeMarkDirtyAndPropogateToDescendants(layout->node);
+
+    layout->availableWidth = std::numeric_limits<float>::quiet_NaN();
+    layout->availableHeight = std::numeric_limits<float>::quiet_NaN();
+}
+
+void LayoutElement::enableIntrinsicSize()
+{
+    intrinsicSize = true;
+
+    if (YGNodeGetChildCount(layout->node) == 0)
+        YGNodeSetMeasureFunc(layout->node, &Layout::measure);
+}
+
+juce::Point<float> LayoutElement::measureContent(float, float)
+{
+    return {};
+}
+
+void LayoutElement::invalidateIntrinsicSize()
+{
+    if (YGNodeHasMeasureFunc(layout->node))
+        YGNodeMarkDirty(layout->node);
 }
 
 void LayoutElement::registerJSPrototype(JSContext* ctx, JSValue prototype)
@@ -536,6 +991,10 @@ void LayoutElement::reconcileElement()
     } else {
         if (layout->node->getOwner() == nullptr) {
             if (auto parentLayoutElement{ getParentLayoutElement() }) {
+                // Yoga does not allow measured nodes to have children.
+                if (YGNodeHasMeasureFunc(parentLayoutElement->layout->node))
+                    YGNodeSetMeasureFunc(parentLayoutElement->layout->node, nullptr);
+
                 const auto count{ YGNodeGetChildCount(parentLayoutElement->layout->node) };
                 YGNodeInsertChild(parentLayoutElement->layout->node, layout->node, count);
             }
@@ -543,6 +1002,16 @@ void LayoutElement::reconcileElement()
     }
 }
 
+void LayoutElement::cloneFrom(const Element& other)
+{
+    StyledElement::cloneFrom(other);
+
+    // Copy the layout style in bulk, so that the layout rebuild
+    // will find nothing to update.
+    if (auto* layoutElement{ dynamic_cast<const LayoutElement*>(&other) })
+        YGNodeCopyStyle(layout->node, layoutElement->layout->node);
+}
+
 //==============================================================================
 
 JSValue LayoutElement::js_getBounds(JSContext* ctx, JSValueConst self)
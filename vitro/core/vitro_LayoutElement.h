@@ -11,6 +11,40 @@ public:
 
     using Ptr = std::shared_ptr<LayoutElement>;
 
+    /** Detached copy of the layout nodes tree.
+
+        A snapshot captures the layout style of an elements subtree, so that
+        the layout can be computed on another thread without touching the elements.
+        The measured elements get measured when the snapshot is taken, for their
+        width and height if these are defined by the style, or unconstrained.
+        A measure function depending on a size resolved by the flex layout
+        (like a stretched height) gets the same result only in the synchronous layout.
+
+        @see createLayoutSnapshot
+        @see applyLayoutSnapshot
+    */
+    class Snapshot final
+    {
+    public:
+        ~Snapshot();
+
+        /** Compute the layout of the captured nodes.
+
+            This method can be called from any thread.
+        */
+        void calculate();
+
+    private:
+        friend class LayoutElement;
+
+        Snapshot();
+
+        struct Impl;
+        std::unique_ptr<Impl> d;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(Snapshot)
+    };
+
     static JSClassID jsClassID;
 
     LayoutElement(const juce::Identifier& elementTag, Context& ctx);
@@ -40,10 +74,20 @@ public:
     */
     LayoutElement::Ptr getParentLayoutElement();
 
+    /** Place this element explicitly within its parent layout.
+
+        The element will be positioned absolutely at the given bounds relative to
+        its parent layout element, regardless of its position, width and height
+        style properties. This is used by the elements that manage their children
+        placement, like VirtualList.
+    */
+    void setLayoutBoundsOverride(const juce::Rectangle<float>& bounds);
+
     /** Call the layout update on the elements tree.
 
         This will cause the a layout to be rebuilt recursively
-        by following the layout nodes. This method only updates the layout nodes
+        by following the layout nodes. Only the nodes which layout style
+        properties have changed since the last update get rebuilt. This method only updates the layout nodes
         properties, but does not perform the actual placement. For this the layout
         engine needs to know the target area, which is done via @ref recalculateLayout
 
@@ -58,17 +102,76 @@ public:
         This method perform the layout computation starting from this element.
         All component elements' bounds will be updated recursively.
         This is a method to be called when resizing the top UI container.
+
+        @note The computation is skipped if neither the layout nodes
+              nor the available size have changed since the last call.
     */
     void recalculateLayout(float width, float height);
 
+    /** Capture the layout nodes tree for an off-thread computation.
+
+        This is the asynchronous counterpart of @ref recalculateLayout.
+        The returned snapshot can be computed on a worker thread, and then
+        applied back via @ref applyLayoutSnapshot on the message thread.
+
+        @return nullptr if neither the layout nodes nor the available
+                size have changed since the last call.
+    */
+    std::unique_ptr<Snapshot> createLayoutSnapshot(float width, float height);
+
+    /** Apply the computed snapshot layout to the elements.
+
+        Only the elements which bounds have changed get updated.
+        The snapshot is applied even if the layout nodes have changed
+        since it has been taken: the layout then lags behind the changes
+        until the newer snapshot gets applied, rather than not following
+        them at all when they keep arriving faster than the layout computation.
+    */
+    void applyLayoutSnapshot(const Snapshot& snapshot);
+
+    /** Force the layout recalculation on the next update.
+
+        This discards all the layout results cached by the layout engine.
+    */
+    void invalidateLayout();
+
     // @internal
     static void registerJSPrototype(JSContext* ctx, JSValue prototype);
 
 protected:
 
     // vitro::Element
+    void update() override;
     void numberOfChildrenChanged() override;
     void reconcileElement() override;
+    void cloneFrom(const Element& other) override;
+
+    /** Tell whether a style property affects the layout only. */
+    static bool isLayoutStyleProperty(const juce::Identifier& name);
+
+    /** Let the layout engine size this element to its content.
+
+        When enabled, the layout engine calls @ref measureContent whenever
+        the element width or height is not defined by its style.
+        This is used by the text-bearing elements.
+        @note Only the elements without layout children can be measured.
+    */
+    void enableIntrinsicSize();
+
+    /** Returns the size of the element's content.
+
+        The available width and height are infinite when unconstrained.
+        The returned size may exceed the available one.
+    */
+    virtual juce::Point<float> measureContent(float availableWidth, float availableHeight);
+
+    /** Tell the layout engine the content size has changed.
+
+        This must be called when the content affecting @ref measureContent
+        changes, so that the element gets measured again on the next layout
+        computation. Otherwise the previous measurement is reused.
+    */
+    void invalidateIntrinsicSize();
 
 private:
 
@@ -84,6 +187,18 @@ private:
     // removing children most likely causes the layout changes.
     bool childrenChanged{ false };
 
+    // Flag indicating the layout style properties have changed
+    // and must be pushed into the layout node.
+    bool layoutStylePending{ true };
+
+    // Explicit placement of this element.
+    // @see setLayoutBoundsOverride
+    std::optional<juce::Rectangle<float>> boundsOverride{};
+
+    // Element is sized to its content.
+    // @see enableIntrinsicSize
+    bool intrinsicSize{ false };
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LayoutElement)
 };
 
@@ -0,0 +1,93 @@
+namespace vitro {
+
+namespace {
+    constexpr size_t kNodesPerBlock = 256;
+}
+
+struct LayoutNodePool::Impl final
+{
+    struct alignas(YGNode) Slot final
+    {
+        std::byte storage[sizeof(YGNode)];
+    };
+
+    std::vector<std::unique_ptr<Slot[]>> blocks{};
+
+    // Number of the slots used in the last block.
+    size_t lastBlockUsed{ kNodesPerBlock };
+
+    // Released slots to be reused.
+    std::vector<Slot*> freeSlots{};
+
+    size_t numAllocated{};
+
+    Slot* acquireSlot()
+    {
+        if (!freeSlots.empty()) {
+            auto* slot{ freeSlots.back() };
+            freeSlots.pop_back();
+            return slot;
+        }
+
+        if (lastBlockUsed == kNodesPerBlock) {
+            blocks.push_back(std::make_unique<Slot[]>(kNodesPerBlock));
+            lastBlockUsed = 0;
+        }
+
+        return &blocks.back()[lastBlockUsed++];
+    }
+};
+
+LayoutNodePool::LayoutNodePool()
+    : d{ std::make_unique<Impl>() }
+{
+}
+
+LayoutNodePool::~LayoutNodePool()
+{
+    // All the nodes must be released before the pool gets deleted.
+    jassert(d->numAllocated == 0);
+}
+
+YGNode* LayoutNodePool::allocate()
+{
+    auto* config{ YGConfigGetDefault() };
+    auto* node{ new (d->acquireSlot()) YGNode{ config } };
+
+    ++d->numAllocated;
+    facebook::yoga::Event::publish<facebook::yoga::Event::NodeAllocation>(node, { config });
+
+    return node;
+}
+
+void LayoutNodePool::release(YGNode* node)
+{
+    if (node == nullptr)
+        return;
+
+    // This mimics YGNodeFree, which we cannot use since it deletes the node.
+    jassert(node->getOwner() == nullptr);
+
+    for (auto* child : node->getChildren())
+        child->setOwner(nullptr);
+
+    node->clearChildren();
+    facebook::yoga::Event::publish<facebook::yoga::Event::NodeDeallocation>(node, { node->getConfig() });
+
+    node->~YGNode();
+
+    d->freeSlots.push_back(reinterpret_cast<Impl::Slot*>(node));
+    --d->numAllocated;
+}
+
+size_t LayoutNodePool::getNumAllocatedNodes() const
+{
+    return d->numAllocated;
+}
+
+size_t LayoutNodePool::getCapacity() const
+{
+    return d->blocks.size() * kNodesPerBlock;
+}
+
+} // namespace vitro
@@ -0,0 +1,49 @@
+struct YGNode;
+
+namespace vitro {
+
+/** Pool of the layout nodes.
+
+    Layout nodes are relatively large objects, and allocating them
+    individually scatters the layout tree across the heap. The pool
+    allocates the nodes in contiguous blocks, so that the nodes created
+    together (which is normally the case when loading a UI tree) end up
+    adjacent in memory. Released nodes are reused for new allocations.
+
+    The pool is owned by the context and must be accessed
+    from the message thread only.
+
+    @see Context::getLayoutNodePool
+*/
+class LayoutNodePool final
+{
+public:
+
+    LayoutNodePool();
+    ~LayoutNodePool();
+
+    /** Allocate a new layout node with the default configuration. */
+    YGNode* allocate();
+
+    /** Release the layout node.
+
+        The node must be detached from its owner. Its children
+        will be detached from it.
+    */
+    void release(YGNode* node);
+
+    /** Returns the number of the nodes currently in use. */
+    size_t getNumAllocatedNodes() const;
+
+    /** Returns the number of the nodes the pool can hold without growing. */
+    size_t getCapacity() const;
+
+private:
+
+    struct Impl;
+    std::unique_ptr<Impl> d;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LayoutNodePool)
+};
+
+} // namespace vitro
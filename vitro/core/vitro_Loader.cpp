@@ -18,10 +18,112 @@ static const char* getBinaryDataResourceNameForFile(const String& filename)
 
 //==============================================================================
 
+/** Background images decoder.
+
+    Images get decoded by a pool of background threads,
+    while the results are delivered on the message thread.
+*/
+class Loader::ImageDecoder final : private juce::AsyncUpdater
+{
+public:
+
+    ImageDecoder(Loader& l)
+        : loader{ l },
+          pool(juce::jlimit(1, 4, juce::SystemStats::getNumCpus() - 1))
+    {
+    }
+
+    ~ImageDecoder() override
+    {
+        // Decoding jobs refer to this object, so they must finish first.
+        pool.removeAllJobs(true, 10000);
+        cancelPendingUpdate();
+    }
+
+    void request(const String& location, ImageCallback&& callback)
+    {
+        auto& callbacks{ pending[location] };
+        const bool alreadyRequested{ !callbacks.empty() };
+
+        // Keep an empty callback as well, to mark the request as pending.
+        callbacks.push_back(std::move(callback));
+
+        if (alreadyRequested)
+            return;
+
+        const auto dir{ loader.hasLocalPath ? loader.localPath : File() };
+
+        pool.addJob([this, location, dir] {
+            Result result{ location };
+            result.image = Loader::readImage(location, dir, result.file);
+
+            const ScopedLock scopedLock(lock);
+            results.push_back(std::move(result));
+            triggerAsyncUpdate();
+        });
+    }
+
+private:
+
+    struct Result final
+    {
+        String location{};
+        Image image{};
+        File file{};
+    };
+
+    // juce::AsyncUpdater
+    void handleAsyncUpdate() override
+    {
+        std::vector<Result> completed{};
+
+        {
+            const ScopedLock scopedLock(lock);
+            std::swap(completed, results);
+        }
+
+        for (auto& result : completed) {
+            if (result.image.isValid())
+                loader.imageCache.add(result.location, result.image);
+
+            if (result.image.isValid() || result.file != File())
+                loader.notifyOnResourceLoaded(result.location, result.file);
+
+            const auto it{ pending.find(result.location) };
+
+            if (it == pending.end())
+                continue;
+
+            // Callbacks may issue new requests, so the list is removed first.
+            auto callbacks{ std::move(it->second) };
+            pending.erase(it);
+
+            for (auto& callback : callbacks) {
+                if (callback)
+                    callback(result.image);
+            }
+        }
+    }
+
+    Loader& loader;
+
+    // Requests waiting for the images to be decoded (message thread only).
+    std::map<String, std::vector<ImageCallback>> pending{};
+
+    CriticalSection lock{};
+    std::vector<Result> results{};
+
+    juce::ThreadPool pool;
+};
+
+//==============================================================================
+
 Loader::Loader()
 {
 }
 
+Loader::~Loader() = default;
+
 void Loader::setLocalDirectory(const juce::File& dir)
 {
     localPath = dir;
@@ -63,19 +165,59 @@ std::unique_ptr<XmlElement> Loader::loadXML(const juce::String& location)
 
 juce::Image Loader::loadImage(const String& location)
 {
-    const auto hash{ location.hashCode64() };
-    auto image{ ImageCache::getFromHashCode(hash) };
+    // The image is drawn at full resolution, so the cache keeps it.
+    auto image{ imageCache.get(location, true) };
 
     if (image.isValid())
         return image;
 
-    if (hasLocalPath) {
-        auto file{ localPath.getChildFile(location) };
+    File file{};
+    image = readImage(location, hasLocalPath ? localPath : File(), file);
 
-        if (file.existsAsFile()) {
+    if (image.isValid())
+        imageCache.add(location, image, true);
+
+    if (image.isValid() || file != File())
+        notifyOnResourceLoaded(location, file);
+
+    return image;
+}
+
+juce::Image Loader::loadImageAsync(const String& location, ImageCallback callback)
+{
+    JUCE_ASSERT_MESSAGE_THREAD
+
+    if (location.isEmpty())
+        return {};
+
+    if (auto image{ imageCache.get(location) }; image.isValid())
+        return image;
+
+    if (imageDecoder == nullptr)
+        imageDecoder = std::make_unique<ImageDecoder>(*this);
+
+    imageDecoder->request(location, std::move(callback));
+
+    return {};
+}
+
+void Loader::prefetchImages(const StringArray& locations)
+{
+    for (const auto& location : locations)
+        loadImageAsync(location, {});
+}
+
+juce::Image Loader::readImage(const String& location, const File& dir, File& file)
+{
+    Image image{};
+
+    if (dir != File()) {
+        file = dir.getChildFile(location);
+
+        if (file.existsAsFile())
             image = ImageFileFormat::loadFrom(file);
-            notifyOnResourceLoaded(location, file);
-        }
+        else
+            file = File();
     }
 
 #if JUCE_TARGET_HAS_BINARY_DATA
@@ -86,15 +228,12 @@ juce::Image Loader::loadImage(const String& location)
 
             if (const auto* data{ BinaryData::getNamedResource(resourceName, size) }) {
                 image = ImageFileFormat::loadFrom(data, size_t(size));
-                notifyOnResourceLoaded(location);
+                file = File();
             }
         }
     }
 #endif
 
-    if (image.isValid())
-        ImageCache::addImageToCache(image, hash);
-
     return image;
 }
 
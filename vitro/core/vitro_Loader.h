@@ -25,7 +25,11 @@ public:
         virtual void onResourceLoaded(const juce::String& location, const juce::File& file) = 0;
     };
 
+    /** Callback receiving an asynchronously loaded image. */
+    using ImageCallback = std::function<void(const juce::Image&)>;
+
     Loader();
+    ~Loader();
 
     /** Specify a local directory to be used to load resources.
 
@@ -41,9 +45,31 @@ public:
     /** Load XML from local resources. */
     std::unique_ptr<juce::XmlElement> loadXML(const juce::String& location);
 
-    /** Load an image from local resources. */
+    /** Load an image from local resources.
+
+        The image is kept in the cache at full resolution, since it is
+        expected to be drawn as is.
+    */
     juce::Image loadImage(const juce::String& location);
 
+    /** Load an image from local resources asynchronously.
+
+        If the image has been loaded already it gets returned immediately
+        and the callback is not called. Otherwise this returns an invalid image,
+        the image gets decoded on a background thread, and the callback
+        is then called on the message thread. The callback receives an invalid
+        image if loading fails.
+
+        Concurrent requests for the same image share a single decoding.
+    */
+    juce::Image loadImageAsync(const juce::String& location, ImageCallback callback);
+
+    /** Start loading the images in background so that they are ready when needed. */
+    void prefetchImages(const juce::StringArray& locations);
+
+    /** Returns the cache of the images loaded by this loader. */
+    ImageCache& getImageCache() { return imageCache; }
+
     /** Register a listener with this loader. */
     void addListener(Listener* listener);
 
@@ -52,11 +78,21 @@ public:
 
 private:
 
+    class ImageDecoder;
+
+    // Read and decode the image, this is safe to be called from any thread.
+    static juce::Image readImage(const juce::String& location, const juce::File& dir, juce::File& file);
+
     bool hasLocalPath{ false };
     juce::File localPath{};
 
     juce::ListenerList<Listener> listeners{};
 
+    ImageCache imageCache{};
+
+    // Created on the first asynchronous image request.
+    std::unique_ptr<ImageDecoder> imageDecoder{};
+
     void notifyOnResourceLoaded(const juce::String& location, const juce::File& file = {});
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(Loader)
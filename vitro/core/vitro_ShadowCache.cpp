@@ -0,0 +1,96 @@
+namespace vitro {
+
+namespace {
+    // Returns the distance from the shadow image edge beyond which the shadow
+    // does not change along the rectangle edge. The blur spreads up to twice
+    // the radius into the rectangle, and the rounded corner adds its radius.
+    int getShadowCornerSize(int radius, float cornerRadius)
+    {
+        return 3 * radius + (int)std::ceil(cornerRadius) + 1;
+    }
+}
+
+void ShadowCache::drawShadow(juce::Graphics& g, juce::Rectangle<int> area, int radius,
+                             juce::Colour colour, float cornerRadius)
+{
+    if (area.isEmpty() || colour.isTransparent())
+        return;
+
+    radius = juce::jmax(0, radius);
+    cornerRadius = juce::jmax(0.0f, cornerRadius);
+
+    const auto bounds{ area.expanded(radius) };
+
+    // The template rectangle has a single pixel row and column between its corners.
+    const int corner{ getShadowCornerSize(radius, cornerRadius) };
+    const int templateSize{ 2 * (corner - radius) + 1 };
+
+    if (area.getWidth() < templateSize || area.getHeight() < templateSize) {
+        if (const auto image{ getShadowImage({ area.getWidth(), area.getHeight() }, radius, colour, cornerRadius) }; image.isValid())
+            g.drawImageAt(image, bounds.getX(), bounds.getY());
+
+        return;
+    }
+
+    const auto image{ getShadowImage({ templateSize, templateSize }, radius, colour, cornerRadius) };
+
+    if (!image.isValid())
+        return;
+
+    // Source and destination slices along each axis: corner, stretched middle, corner.
+    const int imageSize{ image.getWidth() };
+    const int src[]{ 0, corner, corner + 1, imageSize };
+    const int dstX[]{ bounds.getX(), bounds.getX() + corner, bounds.getRight() - corner, bounds.getRight() };
+    const int dstY[]{ bounds.getY(), bounds.getY() + corner, bounds.getBottom() - corner, bounds.getBottom() };
+
+    Graphics::ScopedSaveState state(g);
+
+    // Stretching a single pixel must not blend it with the neighbouring slices.
+    g.setImageResamplingQuality(Graphics::lowResamplingQuality);
+
+    for (int row{ 0 }; row < 3; ++row) {
+        for (int col{ 0 }; col < 3; ++col) {
+            g.drawImage(image, dstX[col], dstY[row], dstX[col + 1] - dstX[col], dstY[row + 1] - dstY[row],
+                               src[col], src[row], src[col + 1] - src[col], src[row + 1] - src[row]);
+        }
+    }
+}
+
+juce::Image ShadowCache::getShadowImage(juce::Point<int> size, int radius,
+                                        juce::Colour colour, float cornerRadius)
+{
+    const String key{ String(size.x) + "x" + String(size.y) + ";" + String(radius)
+                      + ";" + colour.toString() + ";" + String(cornerRadius) };
+
+    if (const auto* image{ shadows.find(key) })
+        return *image;
+
+    Image image(Image::ARGB, size.x + 2 * radius, size.y + 2 * radius, true);
+
+    {
+        Graphics g(image);
+
+        const juce::Rectangle<float> area{ (float)radius, (float)radius, (float)size.x, (float)size.y };
+        const DropShadow shadow{ colour, radius, {} };
+
+        if (cornerRadius > 0.0f) {
+            Path path{};
+            path.addRoundedRectangle(area, cornerRadius);
+            shadow.drawForPath(g, path);
+        } else {
+            shadow.drawForRectangle(g, area.toNearestInt());
+        }
+    }
+
+    // Shadows exceeding the limit alone are rendered on each paint.
+    shadows.add(key, image, (size_t)image.getWidth() * (size_t)image.getHeight() * 4);
+
+    return image;
+}
+
+void ShadowCache::clear()
+{
+    shadows.clear();
+}
+
+} // namespace vitro
@@ -0,0 +1,62 @@
+namespace vitro {
+
+/** Cache of the rendered drop shadows.
+
+    Blurring a shadow is expensive, so the shadows are rendered once
+    and shared by all the elements with the same radius, colour and
+    corner radius. The shadow is rendered for a small rectangle and
+    drawn as nine slices: the corners as they are and the edges
+    stretched, so that neither moving nor resizing an element requires
+    its shadow to be rendered again. Elements smaller than that
+    rectangle get their shadows rendered for their exact size.
+
+    The cache keeps track of the memory taken by the shadow images.
+    When the memory limit is reached the least recently used ones
+    get released.
+
+    @see Context::getShadowCache
+    @see ComponentElement::paintShadow
+*/
+class ShadowCache final
+{
+public:
+
+    /** Default memory limit for all the shadow images. */
+    constexpr static size_t defaultMemoryLimit = 4 * 1024 * 1024;
+
+    ShadowCache() = default;
+
+    /** Paint the shadow of a (rounded) rectangle.
+
+        The shadow covers the rectangle expanded by the blur radius on each side.
+    */
+    void drawShadow(juce::Graphics& g, juce::Rectangle<int> area, int radius,
+                    juce::Colour colour, float cornerRadius);
+
+    /** Assign the memory limit in bytes for all the shadow images. */
+    void setMemoryLimit(size_t bytes) { shadows.setLimit(bytes); }
+
+    size_t getMemoryLimit() const { return shadows.getLimit(); }
+
+    /** Returns the memory in bytes currently taken by the shadow images. */
+    size_t getMemoryUsage() const { return shadows.getUsage(); }
+
+    /** Returns the number of the cached shadows. */
+    size_t getNumCachedShadows() const { return shadows.size(); }
+
+    /** Remove all the cached shadows. */
+    void clear();
+
+private:
+
+    // Returns the shadow image of a rectangle, expanded by the radius on each side.
+    juce::Image getShadowImage(juce::Point<int> size, int radius,
+                               juce::Colour colour, float cornerRadius);
+
+    // Shadow images indexed by the size, radius, colour and corner radius.
+    LRUCache<juce::String, juce::Image, StringHash> shadows{ defaultMemoryLimit };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ShadowCache)
+};
+
+} // namespace vitro
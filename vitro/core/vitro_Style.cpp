@@ -35,9 +35,13 @@ void Style::populate(const String& style)
     const bool shouldPopulate{ style.isNotEmpty() && (!populatedOnce || hash != styleHash) };
 
     if (shouldPopulate) {
-        context.getStylesheet().populateFromString(style);
+        auto& stylesheet{ context.getStylesheet() };
+        stylesheet.populateFromString(style);
         populatedOnce = true;
         styleHash = hash;
+
+        // Start decoding the images before the elements request them.
+        context.getLoader().prefetchImages(stylesheet.getPropertyValues(attr::css::background_image));
     }
 }
 
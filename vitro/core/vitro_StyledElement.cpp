@@ -15,6 +15,12 @@ void StyledElement::setStyleAttribute(const var& value)
 
 void StyledElement::updateStyleProperties()
 {
+    if (stylePreResolved) {
+        // Keep the changes captured when cloning
+        stylePreResolved = false;
+        return;
+    }
+
     changedStyleProperties.clear();
 
     //DBG("Style for <" << getTag() << ">");
@@ -62,6 +68,32 @@ void StyledElement::reconcileElement()
     Element::reconcileElement();
 }
 
+void StyledElement::cloneFrom(const Element& other)
+{
+    Element::cloneFrom(other);
+
+    if (auto* styledElement{ dynamic_cast<const StyledElement*>(&other) }) {
+        localStylesheet = styledElement->localStylesheet;
+
+        for (int i = 0; i < styledElement->styleProperties.size(); ++i) {
+            const auto name{ styledElement->styleProperties.getName(i) };
+
+            if (styleProperties.set(name, styledElement->styleProperties.getValueAt(i)))
+                changedStyleProperties.insert(name);
+        }
+
+        stylePreResolved = true;
+    }
+}
+
+void StyledElement::attributeChanged(const juce::Identifier& name)
+{
+    Element::attributeChanged(name);
+
+    // Attributes affect the selectors matching
+    stylePreResolved = false;
+}
+
 void StyledElement::registerStyleProperty(const juce::Identifier& name, const var& value)
 {
     styleProperties.set(name, value);
@@ -57,7 +57,10 @@ public:
 
 protected:
 
+    // vitro::Element
     void reconcileElement() override;
+    void cloneFrom(const Element& other) override;
+    void attributeChanged(const juce::Identifier& name) override;
 
     /** Register element's style property.
 
@@ -79,6 +82,9 @@ protected:
     */
     bool isStylePropertyChanged(const juce::Identifier& name) const;
 
+    /** Returns the style properties changed since the last update. */
+    const std::set<juce::Identifier>& getChangedStyleProperties() const { return changedStyleProperties; }
+
     /** Assign a default value for a style property.
 
         Whenever a local or global stylesheet return no result for a style property,
@@ -100,6 +106,10 @@ private:
     // List of style properties changes since the last update.
     std::set<juce::Identifier> changedStyleProperties{};
 
+    // Style properties have been copied from another element when cloning,
+    // so there is no need to resolve them again until the attributes change.
+    bool stylePreResolved{ false };
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(StyledElement)
 };
 
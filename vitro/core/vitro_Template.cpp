@@ -0,0 +1,144 @@
+namespace vitro {
+
+JSClassID Template::jsClassID = 0;
+
+const Identifier Template::tag("template");
+
+Template::Template(Context& ctx)
+    : Element(Template::tag, ctx)
+{
+}
+
+void Template::forwardXmlElement(const juce::XmlElement& xml)
+{
+    prototypes.clear();
+    prototypesResolved = false;
+
+    const auto addPrototype = [this](const juce::XmlElement& prototypeXml) {
+        // Prototypes are never shown, so we don't evaluate their onload scripts.
+        if (auto prototype{ Element::createFromXml(context, prototypeXml, false) })
+            prototypes.push_back(prototype);
+    };
+
+    // xml here may represent this <template> element,
+    // in which case all its children make the template content.
+    if (xml.getTagName() == Template::tag.toString()) {
+        for (auto* child : xml.getChildIterator()) {
+            if (!child->isTextElement())
+                addPrototype(*child);
+        }
+    } else {
+        addPrototype(xml);
+    }
+}
+
+std::vector<Element::Ptr> Template::instantiate(const juce::var& data)
+{
+    if (!prototypesResolved) {
+        for (auto&& prototype : prototypes) {
+            prototype->forceUpdate();
+
+            // Build the layout nodes style, so that it can be copied to the instances.
+            if (auto layoutElement{ std::dynamic_pointer_cast<LayoutElement>(prototype) })
+                layoutElement->updateLayout();
+        }
+
+        prototypesResolved = true;
+    }
+
+    std::vector<Element::Ptr> instances{};
+    instances.reserve(prototypes.size());
+
+    for (auto&& prototype : prototypes) {
+        if (auto instance{ prototype->cloneElement(true) }) {
+            if (auto* obj{ data.getDynamicObject() }) {
+                const ScopedUpdateBatch batch(*instance);
+
+                for (const auto& prop : obj->getProperties())
+                    instance->setAttribute(prop.name, prop.value);
+            }
+
+            instance->evaluateOnLoadScript(true);
+            instances.push_back(instance);
+        }
+    }
+
+    return instances;
+}
+
+void Template::registerJSPrototype(JSContext* ctx, JSValue prototype)
+{
+    Element::registerJSPrototype(ctx, prototype);
+
+    registerJSMethod(ctx, prototype, "instantiate", &js_instantiate);
+}
+
+void Template::cloneFrom(const Element& other)
+{
+    Element::cloneFrom(other);
+
+    if (auto* otherTemplate{ dynamic_cast<const Template*>(&other) }) {
+        // Prototypes are never modified, so they can be shared.
+        prototypes = otherTemplate->prototypes;
+        prototypesResolved = otherTemplate->prototypesResolved;
+    }
+}
+
+//==============================================================================
+
+JSValue Template::js_instantiate(JSContext* ctx, JSValueConst self, int argc, JSValueConst* arg)
+{
+    if (argc > 2)
+        return JS_ThrowSyntaxError(ctx, "instantiate expects up to two arguments - data and parent element");
+
+    auto templ{ Context::getJSNativeObject<Template>(self) };
+
+    if (templ == nullptr)
+        return JS_UNDEFINED;
+
+    const juce::var data{ argc > 0 ? js::JSValueToVar(ctx, arg[0]) : juce::var() };
+    Element::Ptr parent{ argc > 1 ? Context::getJSNativeObject<Element>(arg[1]) : nullptr };
+
+    if (argc > 1 && parent == nullptr)
+        return JS_ThrowTypeError(ctx, "instantiate expects an element as a parent");
+
+    // An array of data produces an instance per item
+    std::vector<Element::Ptr> instances{};
+
+    if (const auto* items{ data.getArray() }) {
+        instances.reserve(size_t(items->size()) * templ->prototypes.size());
+
+        for (const auto& item : *items) {
+            for (auto&& instance : templ->instantiate(item))
+                instances.push_back(instance);
+        }
+    } else {
+        instances = templ->instantiate(data);
+    }
+
+    // Attach all the instances at once
+    if (parent != nullptr)
+        parent->appendChildElements(instances);
+
+    const auto toJSValue = [parent](const Element::Ptr& instance) {
+        // The JS object must exist before stashing the element.
+        auto jsInstance{ instance->duplicateJSValue() };
+
+        if (parent == nullptr)
+            instance->stash();
+
+        return jsInstance;
+    };
+
+    if (instances.size() == 1 && !data.isArray())
+        return toJSValue(instances.front());
+
+    auto arr{ JS_NewArray(ctx) };
+
+    for (size_t i = 0; i < instances.size(); ++i)
+        JS_SetPropertyUint32(ctx, arr, static_cast<uint32_t>(i), toJSValue(instances[i]));
+
+    return arr;
+}
+
+} // namespace vitro
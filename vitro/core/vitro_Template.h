@@ -0,0 +1,66 @@
+namespace vitro {
+
+/** Template element.
+
+    This is a non-visual element that holds a prototype subtree,
+    which can be instantiated multiple times:
+
+    <template id="card">
+        <Panel class="card">
+            <Label class="title" />
+        </Panel>
+    </template>
+
+    The template content is not a part of the elements tree. Instances are
+    cloned from the prototype elements with their attributes, resolved style
+    and layout style copied in bulk, which is much faster than creating
+    the same elements one by one.
+
+    @see Element::cloneElement
+*/
+class Template : public Element
+{
+public:
+
+    const static juce::Identifier tag;  // <template>
+
+    static JSClassID jsClassID;
+
+    Template(Context& ctx);
+
+    // vitro::Element
+    JSClassID getJSClassID() const override { return vitro::Template::jsClassID; }
+
+    bool hasInnerXml() const override { return true; }
+
+    void forwardXmlElement(const juce::XmlElement& xml) override;
+
+    /** Create a new instance of the template content.
+
+        If data is an object, its properties will be assigned as attributes
+        to the top-level instantiated elements.
+
+        @return Instantiated top-level elements (not attached to any parent).
+    */
+    std::vector<Element::Ptr> instantiate(const juce::var& data = {});
+
+    static void registerJSPrototype(JSContext* ctx, JSValue prototype);
+
+protected:
+
+    // vitro::Element
+    void cloneFrom(const Element& other) override;
+
+private:
+
+    static JSValue js_instantiate(JSContext* ctx, JSValueConst self, int argc, JSValueConst* arg);
+
+    // Top-level elements of the template content.
+    std::vector<Element::Ptr> prototypes{};
+
+    // Prototypes style is resolved on the first instantiation,
+    // so that all the stylesheets have been loaded by then.
+    bool prototypesResolved{ false };
+};
+
+} // namespace vitro
@@ -0,0 +1,39 @@
+namespace vitro {
+
+namespace {
+    // Enough to hold the texts of any reasonable UI,
+    // the least recently used entries get evicted beyond that.
+    constexpr size_t kMaxCachedEntries = 4096;
+}
+
+TextMetrics::TextMetrics()
+    : widths{ kMaxCachedEntries }
+{
+}
+
+float TextMetrics::getStringWidth(const juce::Font& font, const juce::String& text)
+{
+    if (text.isEmpty())
+        return 0.0f;
+
+    // Font::toString does not include the kerning, so we add it explicitly.
+    const String key{ font.toString() + ";" + String(font.getExtraKerningFactor()) + "\n" + text };
+
+    if (const auto* width{ widths.find(key) })
+        return *width;
+
+    GlyphArrangement glyphs{};
+    glyphs.addLineOfText(font, text, 0.0f, 0.0f);
+
+    const float width{ glyphs.getBoundingBox(0, -1, true).getWidth() };
+    widths.add(key, width);
+
+    return width;
+}
+
+void TextMetrics::clear()
+{
+    widths.clear();
+}
+
+} // namespace vitro
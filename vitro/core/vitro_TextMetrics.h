@@ -0,0 +1,36 @@
+namespace vitro {
+
+/** Text metrics cache.
+
+    This class caches the width of text strings rendered with a given font.
+    It is shared by all the elements of a context and used by the text-bearing
+    elements to compute their intrinsic size. Measuring a string is relatively
+    expensive, while the same labels get measured over and over again on each
+    layout computation.
+
+    @see Context::getTextMetrics
+*/
+class TextMetrics final
+{
+public:
+
+    TextMetrics();
+
+    /** Returns the width of a single line of text rendered with the given font. */
+    float getStringWidth(const juce::Font& font, const juce::String& text);
+
+    /** Returns the number of the cached entries. */
+    size_t getNumCachedEntries() const { return widths.size(); }
+
+    /** Remove all the cached entries. */
+    void clear();
+
+private:
+
+    // Text width indexed by the font description and the text itself.
+    LRUCache<juce::String, float, StringHash> widths;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(TextMetrics)
+};
+
+} // namespace vitro
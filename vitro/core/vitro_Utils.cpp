@@ -360,6 +360,153 @@ Gradient Gradient::fromString(const String& str)
 
 namespace js {
 
+namespace {
+
+// QuickJS does not expose the built-in class IDs, but these are the same
+// for all the contexts, so they are captured once from the sample objects.
+struct BinaryClassIDs final
+{
+    JSClassID arrayBuffer{};
+    JSClassID float32Array{};
+    std::array<JSClassID, 9> typedArrays{};
+
+    bool isBinary(JSClassID classID) const
+    {
+        return classID != 0
+            && (classID == arrayBuffer || std::find(typedArrays.begin(), typedArrays.end(), classID) != typedArrays.end());
+    }
+};
+
+JSClassID getGlobalConstructedClassID(JSContext* ctx, const char* className)
+{
+    auto global{ JS_GetGlobalObject(ctx) };
+    auto ctor{ JS_GetPropertyStr(ctx, global, className) };
+    auto arg{ JS_NewInt32(ctx, 0) };
+    auto obj{ JS_CallConstructor(ctx, ctor, 1, &arg) };
+
+    JSClassID classID{};
+
+    if (JS_IsException(obj))
+        JS_FreeValue(ctx, JS_GetException(ctx));
+    else
+        classID = JS_GetClassID(obj, nullptr);
+
+    JS_FreeValue(ctx, obj);
+    JS_FreeValue(ctx, ctor);
+    JS_FreeValue(ctx, global);
+
+    return classID;
+}
+
+const BinaryClassIDs& getBinaryClassIDs(JSContext* ctx)
+{
+    static const BinaryClassIDs ids{ [ctx] {
+        BinaryClassIDs classIDs{};
+        classIDs.arrayBuffer = getGlobalConstructedClassID(ctx, "ArrayBuffer");
+
+        const char* typedArrays[] {
+            "Int8Array", "Uint8Array", "Uint8ClampedArray",
+            "Int16Array", "Uint16Array", "Int32Array", "Uint32Array",
+            "Float32Array", "Float64Array"
+        };
+
+        for (size_t i = 0; i < classIDs.typedArrays.size(); ++i)
+            classIDs.typedArrays[i] = getGlobalConstructedClassID(ctx, typedArrays[i]);
+
+        classIDs.float32Array = classIDs.typedArrays[7];
+
+        return classIDs;
+    }() };
+
+    return ids;
+}
+
+JSValue newFloat32ArrayView(JSContext* ctx, JSValue buffer)
+{
+    if (JS_IsException(buffer))
+        return buffer;
+
+    auto global{ JS_GetGlobalObject(ctx) };
+    auto ctor{ JS_GetPropertyStr(ctx, global, "Float32Array") };
+    auto view{ JS_CallConstructor(ctx, ctor, 1, &buffer) };
+
+    JS_FreeValue(ctx, ctor);
+    JS_FreeValue(ctx, global);
+    JS_FreeValue(ctx, buffer);
+
+    return view;
+}
+
+} // anonymous namespace
+
+const void* getArrayBufferData(JSContext* ctx, JSValueConst val, size_t& numBytes)
+{
+    numBytes = 0;
+
+    const auto& classIDs{ getBinaryClassIDs(ctx) };
+    const auto classID{ JS_GetClassID(val, nullptr) };
+
+    if (!classIDs.isBinary(classID))
+        return nullptr;
+
+    const uint8_t* data{ nullptr };
+
+    if (classID == classIDs.arrayBuffer) {
+        data = JS_GetArrayBuffer(ctx, &numBytes, val);
+    } else {
+        size_t offset{};
+        size_t length{};
+        size_t bytesPerElement{};
+        auto buffer{ JS_GetTypedArrayBuffer(ctx, val, &offset, &length, &bytesPerElement) };
+
+        if (!JS_IsException(buffer)) {
+            size_t bufferSize{};
+
+            if (const auto* bufferData{ JS_GetArrayBuffer(ctx, &bufferSize, buffer) }; bufferData != nullptr && offset + length <= bufferSize) {
+                data = bufferData + offset;
+                numBytes = length;
+            }
+        }
+
+        JS_FreeValue(ctx, buffer);
+    }
+
+    // Detached buffers throw
+    if (data == nullptr) {
+        numBytes = 0;
+        JS_FreeValue(ctx, JS_GetException(ctx));
+    }
+
+    return data;
+}
+
+const float* getFloat32ArrayData(JSContext* ctx, JSValueConst val, size_t& numValues)
+{
+    numValues = 0;
+
+    const auto& classIDs{ getBinaryClassIDs(ctx) };
+    const auto classID{ JS_GetClassID(val, nullptr) };
+
+    if (classID == 0 || (classID != classIDs.float32Array && classID != classIDs.arrayBuffer))
+        return nullptr;
+
+    size_t numBytes{};
+    const auto* data{ getArrayBufferData(ctx, val, numBytes) };
+
+    // Misaligned memory cannot be accessed as floats
+    if (data == nullptr || reinterpret_cast<uintptr_t>(data) % alignof(float) != 0)
+        return nullptr;
+
+    numValues = numBytes / sizeof(float);
+
+    return static_cast<const float*>(data);
+}
+
+JSValue newFloat32Array(JSContext* ctx, const float* values, size_t numValues)
+{
+    return newFloat32ArrayView(ctx, JS_NewArrayBufferCopy(ctx, reinterpret_cast<const uint8_t*>(values), numValues * sizeof(float)));
+}
+
 var JSValueToVar(JSContext* ctx, JSValueConst val)
 {
     const auto tag{ JS_VALUE_GET_TAG (val) };
@@ -393,6 +540,18 @@ var JSValueToVar(JSContext* ctx, JSValueConst val)
         if (JS_IsFunction(ctx, val))
             return var(new js::Function(ctx, val));
 
+        // Float32Array keeps its type, so that it can be read as floats later.
+        if (JS_GetClassID(val, nullptr) == getBinaryClassIDs(ctx).float32Array) {
+            if (size_t numValues{}; const auto* values{ getFloat32ArrayData(ctx, val, numValues) }) {
+                auto buffer{ SharedBuffer::createFloat32(numValues) };
+                buffer->copyFrom(values, numValues * sizeof(float));
+                return buffer.get();
+            }
+        }
+
+        if (size_t numBytes{}; const auto* data{ getArrayBufferData(ctx, val, numBytes) })
+            return MemoryBlock(data, numBytes);
+
         if (JS_IsArray(ctx, val)) {
             Array<var> arr{};
             int length{};
@@ -414,13 +573,21 @@ var JSValueToVar(JSContext* ctx, JSValueConst val)
         uint32_t numProps{};
 
         if (JS_GetOwnPropertyNames(ctx, &props, &numProps, val, JS_GPN_STRING_MASK | JS_GPN_ENUM_ONLY) == 0) {
+            auto* context{ Context::getContextFromJSContext(ctx) };
+
             for (uint32_t i = 0; i < numProps; ++i) {
-                auto propKey{ JS_AtomToCString (ctx, props[i].atom) };
                 auto propVal{ JS_GetProperty(ctx, val, props[i].atom) };
-                obj->setProperty(propKey, JSValueToVar(ctx, propVal));
+
+                if (context != nullptr) {
+                    if (const auto propKey{ context->getAtomCache().getIdentifier(ctx, props[i].atom) }; propKey.isValid())
+                        obj->setProperty(propKey, JSValueToVar(ctx, propVal));
+                } else {
+                    auto propKey{ JS_AtomToCString (ctx, props[i].atom) };
+                    obj->setProperty(propKey, JSValueToVar(ctx, propVal));
+                    JS_FreeCString(ctx, propKey);
+                }
 
                 JS_FreeValue(ctx, propVal);
-                JS_FreeCString(ctx, propKey);
             }
 
             js_free_prop_enum(ctx, props, numProps);
@@ -452,6 +619,8 @@ JSValue varToJSValue(JSContext* ctx, const var& val)
         return JS_NewFloat64(ctx, double(val));
     if (val.isString())
         return JS_NewString(ctx, val.toString().toRawUTF8());
+    if (auto* block{ val.getBinaryData() })
+        return JS_NewArrayBufferCopy(ctx, static_cast<const uint8_t*>(block->getData()), block->getSize());
     if (val.isArray()) {
         auto jsArr{ JS_NewArray (ctx) };
         int i{};
@@ -467,11 +636,25 @@ JSValue varToJSValue(JSContext* ctx, const var& val)
             return JS_DupValue(ctx, func->getJSValue());
         }
 
+        if (auto* buffer{ dynamic_cast<SharedBuffer*>(val.getObject()) })
+            return buffer->createJSValue(ctx);
+
         if (auto* obj{ val.getDynamicObject()} ) {
             auto jsObj{ JS_NewObject(ctx) };
+            auto* context{ Context::getContextFromJSContext(ctx) };
+
+            for (auto& prop : obj->getProperties()) {
+                // The value must be converted before retrieving the atom,
+                // since the nested conversions may flush the atoms cache.
+                auto propVal{ varToJSValue(ctx, prop.value) };
+
+                const auto atom{ context != nullptr ? context->getAtomCache().getAtom(ctx, prop.name) : JS_ATOM_NULL };
 
-            for (auto& prop : obj->getProperties())
-                JS_SetPropertyStr(ctx, jsObj, prop.name.toString().toRawUTF8(), varToJSValue(ctx, prop.value));
+                if (atom != JS_ATOM_NULL)
+                    JS_SetProperty(ctx, jsObj, atom, propVal);
+                else
+                    JS_SetPropertyStr(ctx, jsObj, prop.name.toString().toRawUTF8(), propVal);
+            }
 
             return jsObj;
         }
@@ -492,6 +675,46 @@ Function::~Function()
     JS_FreeValue(jsCtx, jsFunc);
 }
 
+//==============================================================================
+
+SharedBuffer::SharedBuffer(size_t numBytes, Type bufferType)
+    : block(numBytes, true),
+      type{ bufferType }
+{
+}
+
+SharedBuffer::Ptr SharedBuffer::createFloat32(size_t numValues)
+{
+    return new SharedBuffer(numValues * sizeof(float), Type::Float32Array);
+}
+
+void SharedBuffer::copyFrom(const void* src, size_t numBytes, size_t offset)
+{
+    block.copyFrom(src, (int)offset, numBytes);
+}
+
+JSValue SharedBuffer::createJSValue(JSContext* ctx)
+{
+    // The reference is released when the ArrayBuffer gets finalized.
+    incReferenceCount();
+
+    auto buffer{ JS_NewArrayBuffer(ctx, static_cast<uint8_t*>(block.getData()), block.getSize(),
+        [](JSRuntime*, void* opaque, void*) {
+            static_cast<SharedBuffer*>(opaque)->decReferenceCount();
+        },
+        this, false) };
+
+    if (JS_IsException(buffer)) {
+        decReferenceCount();
+        return buffer;
+    }
+
+    if (type == Type::Float32Array)
+        return newFloat32ArrayView(ctx, buffer);
+
+    return buffer;
+}
+
 } // namespace js
 
 } // namespace vitro
@@ -74,14 +74,237 @@ private:
 
 //==============================================================================
 
+/** Hash of juce::String for the unordered containers. */
+struct StringHash final
+{
+    size_t operator()(const juce::String& s) const noexcept { return (size_t)s.hash(); }
+};
+
+/** Cache evicting the least recently used entries.
+
+    Each entry has a cost, such as its memory size in bytes, or 1 to limit
+    the number of entries. Once the total cost exceeds the limit, the least
+    recently used entries get removed. An entry exceeding the limit alone
+    is not cached.
+
+    This class is not thread-safe.
+*/
+template<typename Key, typename Value, typename Hash = std::hash<Key>>
+class LRUCache final
+{
+public:
+
+    explicit LRUCache(size_t costLimit)
+        : limit{ costLimit }
+    {
+    }
+
+    /** Returns the cached value, or nullptr if not cached.
+
+        The entry becomes the most recently used one. The returned
+        pointer remains valid until the entry gets removed.
+    */
+    Value* find(const Key& key)
+    {
+        const auto it{ index.find(key) };
+
+        if (it == index.end())
+            return nullptr;
+
+        entries.splice(entries.begin(), entries, it->second);
+        return &it->second->value;
+    }
+
+    /** Add or replace an entry, evicting the least recently used ones.
+
+        This returns false if the entry exceeds the limit alone,
+        in which case it is not cached.
+    */
+    bool add(const Key& key, Value value, size_t cost = 1)
+    {
+        remove(key);
+
+        if (cost > limit)
+            return false;
+
+        entries.push_front({ key, std::move(value), cost });
+        index.emplace(key, entries.begin());
+        usage += cost;
+
+        evict();
+        return true;
+    }
+
+    /** Remove an entry if cached. */
+    void remove(const Key& key)
+    {
+        if (const auto it{ index.find(key) }; it != index.end())
+            erase(it->second);
+    }
+
+    /** Assign the limit of the total cost of the entries. */
+    void setLimit(size_t costLimit)
+    {
+        limit = costLimit;
+        evict();
+    }
+
+    size_t getLimit() const { return limit; }
+
+    /** Returns the total cost of the cached entries. */
+    size_t getUsage() const { return usage; }
+
+    /** Returns the number of the cached entries. */
+    size_t size() const { return entries.size(); }
+
+    /** Remove all the entries. */
+    void clear()
+    {
+        while (!entries.empty())
+            erase(std::prev(entries.end()));
+    }
+
+    /** Called with each entry being removed from the cache.
+
+        This is not called when the cache gets destroyed.
+    */
+    std::function<void(const Key&, Value&)> onRemove;
+
+private:
+
+    struct Entry final
+    {
+        Key key;
+        Value value;
+        size_t cost;
+    };
+
+    using Iterator = typename std::list<Entry>::iterator;
+
+    void evict()
+    {
+        while (usage > limit && !entries.empty())
+            erase(std::prev(entries.end()));
+    }
+
+    void erase(Iterator it)
+    {
+        if (onRemove)
+            onRemove(it->key, it->value);
+
+        usage -= it->cost;
+        index.erase(it->key);
+        entries.erase(it);
+    }
+
+    // Entries from the most to the least recently used.
+    std::list<Entry> entries{};
+    std::unordered_map<Key, Iterator, Hash> index{};
+
+    size_t limit;
+    size_t usage{};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LRUCache)
+};
+
+//==============================================================================
+
 namespace js {
 
-/** Convert JSValue to juce::var */
+/** Convert JSValue to juce::var
+
+    Float32Array is copied into a SharedBuffer, whereas ArrayBuffer and
+    other typed arrays are converted to binary data (juce::MemoryBlock).
+    Both are converted with a single copy.
+*/
 juce::var JSValueToVar(JSContext* ctx, JSValueConst val);
 
-/** Convert juce::var to JSValue */
+/** Convert juce::var to JSValue
+
+    Binary data gets copied into a new ArrayBuffer,
+    whereas a SharedBuffer gets exposed without copying.
+*/
 JSValue varToJSValue(JSContext* ctx, const juce::var& val);
 
+/** Returns the memory of an ArrayBuffer or a typed array.
+
+    The returned pointer refers to the JavaScript owned memory,
+    which remains valid as long as the value is alive and the
+    buffer is not detached. This returns nullptr if the value
+    is not an ArrayBuffer or a typed array.
+*/
+const void* getArrayBufferData(JSContext* ctx, JSValueConst val, size_t& numBytes);
+
+/** Returns the values of a Float32Array.
+
+    An ArrayBuffer is accepted as well, in which case its content is
+    interpreted as floats. This returns nullptr for other values,
+    or if the memory is not aligned for floats.
+
+    @see getArrayBufferData
+*/
+const float* getFloat32ArrayData(JSContext* ctx, JSValueConst val, size_t& numValues);
+
+/** Create a Float32Array with a copy of the values. */
+JSValue newFloat32Array(JSContext* ctx, const float* values, size_t numValues);
+
+/** Memory buffer shared between C++ and JavaScript.
+
+    The buffer is exposed to JavaScript without copying, as an ArrayBuffer
+    or a Float32Array over the same memory. Each JavaScript object holds
+    a reference to the buffer, so that the memory remains valid until
+    released by both C++ and JavaScript.
+
+    The buffer size is fixed, since the JavaScript objects refer to its memory.
+    A buffer can be stored in juce::var, and hence assigned as an element's
+    attribute, in which case the script will receive it without copying.
+
+    @note Writing to the buffer is not synchronized with the script.
+*/
+class SharedBuffer final : public juce::ReferenceCountedObject
+{
+public:
+
+    using Ptr = juce::ReferenceCountedObjectPtr<SharedBuffer>;
+
+    /** JavaScript representation of the buffer. */
+    enum class Type
+    {
+        ArrayBuffer,
+        Float32Array
+    };
+
+    SharedBuffer(size_t numBytes, Type bufferType = Type::ArrayBuffer);
+
+    /** Create a buffer to be exposed as a Float32Array. */
+    static Ptr createFloat32(size_t numValues);
+
+    Type getType() const noexcept { return type; }
+
+    void* getData() noexcept { return block.getData(); }
+    const void* getData() const noexcept { return block.getData(); }
+    size_t getSize() const noexcept { return block.getSize(); }
+
+    float* getFloats() noexcept { return static_cast<float*>(block.getData()); }
+    const float* getFloats() const noexcept { return static_cast<const float*>(block.getData()); }
+    size_t getNumFloats() const noexcept { return block.getSize() / sizeof(float); }
+
+    /** Returns the buffer memory. */
+    const juce::MemoryBlock& getMemoryBlock() const noexcept { return block; }
+
+    /** Copy data into the buffer, clipped to the buffer size. */
+    void copyFrom(const void* src, size_t numBytes, size_t offset = 0);
+
+    /** Create a JavaScript object referring to this buffer. */
+    JSValue createJSValue(JSContext* ctx);
+
+private:
+    juce::MemoryBlock block;
+    Type type;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SharedBuffer)
+};
+
 /** JavaScript function wrapper.
 
     This is a JS function wrapper so that functions can be
@@ -4,6 +4,130 @@ const Identifier View::tag("View");
 
 JSClassID View::jsClassID = 0;
 
+namespace {
+    // Resizing is considered finished when there were
+    // no resize events within this interval.
+    constexpr juce::uint32 kResizeSettleTimeMs = 150;
+}
+
+/** Worker thread computing the view layout.
+
+    The layout snapshots are passed through a double buffer: the requested one
+    waiting to be computed, and the computed one waiting to be applied.
+    Each new request supersedes the previous ones that have not been computed yet.
+    A computed snapshot is applied even if a newer one has been requested since,
+    so that the layout keeps following the changes arriving faster than it
+    gets computed. Only the results older than the applied one are dropped.
+*/
+class View::AsyncLayout final : private juce::Thread,
+                                private juce::AsyncUpdater
+{
+public:
+
+    AsyncLayout(View& v)
+        : juce::Thread("vitro layout"),
+          view{ v }
+    {
+        startThread();
+    }
+
+    ~AsyncLayout()
+    {
+        cancelPendingUpdate();
+        signalThreadShouldExit();
+        notify();
+        stopThread(-1);
+    }
+
+    void request(std::unique_ptr<LayoutElement::Snapshot> snapshot)
+    {
+        {
+            const juce::ScopedLock lock(mutex);
+
+            if (requested != nullptr)
+                ++view.context.getInstrumentation().layout.passesDropped;
+
+            requested = std::move(snapshot);
+            ++requestedGeneration;
+        }
+
+        notify();
+    }
+
+private:
+
+    // juce::Thread
+    void run() override
+    {
+        while (!threadShouldExit()) {
+            std::unique_ptr<LayoutElement::Snapshot> snapshot{};
+            juce::uint64 generation{};
+
+            {
+                const juce::ScopedLock lock(mutex);
+                snapshot = std::move(requested);
+                generation = requestedGeneration;
+            }
+
+            if (snapshot == nullptr) {
+                wait(-1);
+                continue;
+            }
+
+            snapshot->calculate();
+
+            {
+                const juce::ScopedLock lock(mutex);
+                computed = std::move(snapshot);
+                computedGeneration = generation;
+            }
+
+            triggerAsyncUpdate();
+        }
+    }
+
+    // juce::AsyncUpdater
+    void handleAsyncUpdate() override
+    {
+        std::unique_ptr<LayoutElement::Snapshot> snapshot{};
+        juce::uint64 generation{};
+
+        {
+            const juce::ScopedLock lock(mutex);
+            snapshot = std::move(computed);
+            generation = computedGeneration;
+        }
+
+        if (snapshot == nullptr)
+            return;
+
+        if (generation <= appliedGeneration) {
+            ++view.context.getInstrumentation().layout.passesDropped;
+            return;
+        }
+
+        appliedGeneration = generation;
+
+        // Moved components get repainted by themselves.
+        view.applyLayoutSnapshot(*snapshot);
+    }
+
+    View& view;
+
+    juce::CriticalSection mutex{};
+
+    std::unique_ptr<LayoutElement::Snapshot> requested{};
+    std::unique_ptr<LayoutElement::Snapshot> computed{};
+
+    juce::uint64 requestedGeneration{};
+    juce::uint64 computedGeneration{};
+
+    // Accessed on the message thread only.
+    juce::uint64 appliedGeneration{};
+};
+
+//==============================================================================
+
 View::View(Context& ctx)
     : ComponentElementWithBackground(View::tag, ctx)
 {
@@ -13,6 +137,9 @@ View::~View()
 {
     inDestructor = true;
 
+    asyncLayout.reset();
+    frameTick.reset();
+
     // We must remove all the children in order for them to be notified
     // that they are about to be deleted. This is important for some
     // element to release resources and perform cleaning up.
@@ -30,10 +157,58 @@ void View::exposeToJS()
 {
     auto jsCtx{ context.getJSContext() };
     auto global{ JS_GetGlobalObject(jsCtx) };
-    JS_SetPropertyStr(jsCtx, global, "view", JS_DupValue(jsCtx, jsValue));
+    JS_SetPropertyStr(jsCtx, global, "view", duplicateJSValue());
     JS_FreeValue(jsCtx, global);
 }
 
+void View::setAsyncLayoutEnabled(bool shouldBeEnabled)
+{
+    if (shouldBeEnabled == isAsyncLayoutEnabled())
+        return;
+
+    if (shouldBeEnabled) {
+        asyncLayout = std::make_unique<AsyncLayout>(*this);
+    } else {
+        asyncLayout.reset();
+
+        // Layout engine caches are not maintained by the snapshots.
+        invalidateLayout();
+    }
+
+    recalculateLayoutToCurrentBounds();
+}
+
+void View::setResizeMode(ResizeMode mode)
+{
+    if (mode == resizeMode)
+        return;
+
+    resizeMode = mode;
+
+    if (resizeMode == ResizeMode::immediate) {
+        frameTick.reset();
+
+        if (resizePending) {
+            resizePending = false;
+            resizeSnapshot = {};
+
+            recalculateLayoutToCurrentBounds();
+            updateGradientToComponentSize();
+            repaint();
+        }
+    } else if (frameTick == nullptr) {
+        frameTick = std::make_unique<juce::VBlankAttachment>(this, [this] { handleFrameTick(); });
+    }
+}
+
+void View::setPaintFlashingEnabled(bool shouldBeEnabled)
+{
+    if (paintFlashing != shouldBeEnabled) {
+        paintFlashing = shouldBeEnabled;
+        repaint();
+    }
+}
+
 void View::registerJSPrototype(JSContext* jsCtx, JSValue prototype)
 {
     ComponentElement::registerJSPrototype(jsCtx, prototype);
@@ -44,8 +219,23 @@ void View::registerJSPrototype(JSContext* jsCtx, JSValue prototype)
 
 void View::resized()
 {
-    recalculateLayoutToCurrentBounds();
-    updateGradientToComponentSize();
+    if (resizeMode == ResizeMode::immediate) {
+        recalculateLayoutToCurrentBounds();
+        updateGradientToComponentSize();
+        return;
+    }
+
+    // Capture the view as it has been rendered for the last computed layout.
+    // The view has been resized already, so the snapshot must not be clipped
+    // to the new bounds, otherwise a shrinking view would lose its edges.
+    if (resizeMode == ResizeMode::scaled && !resizeSnapshot.isValid() && !laidOutBounds.isEmpty())
+        resizeSnapshot = createComponentSnapshot(laidOutBounds, false, Component::getApproximateScaleFactorForComponent(this));
+
+    resizePending = true;
+    lastResizeTime = Time::getMillisecondCounter();
+
+    if (resizeSnapshot.isValid())
+        repaint();
 }
 
 void View::paint(Graphics& g)
@@ -53,10 +243,42 @@ void View::paint(Graphics& g)
     paintBackground(g);
 }
 
+void View::paintOverChildren(Graphics& g)
+{
+    if (resizeSnapshot.isValid()) {
+        paintBackground(g);
+        g.drawImage(resizeSnapshot, getLocalBounds().toFloat());
+    }
+
+    if (paintFlashing) {
+        // Each repaint gets a different tint, so that
+        // the subsequently repainted regions can be told apart.
+        paintFlashingHue = std::fmod(paintFlashingHue + 0.17f, 1.0f);
+        g.fillAll(juce::Colour::fromHSV(paintFlashingHue, 1.0f, 1.0f, 0.25f));
+    }
+}
+
 void View::update()
 {
     ComponentElementWithBackground::update();
 
+    if (auto&& [changed, val]{ getAttributeChanged(attr::asynclayout) }; changed)
+        setAsyncLayoutEnabled(val);
+
+    if (auto&& [changed, val]{ getAttributeChanged(attr::paintflashing) }; changed)
+        setPaintFlashingEnabled(val);
+
+    if (auto&& [changed, val]{ getAttributeChanged(attr::resizemode) }; changed) {
+        const static std::map<String, ResizeMode> modes {
+            { "immediate", ResizeMode::immediate },
+            { "coalesced", ResizeMode::coalesced },
+            { "scaled",    ResizeMode::scaled    }
+        };
+
+        const auto it{ modes.find(val.toString()) };
+        setResizeMode(it != modes.end() ? it->second : ResizeMode::immediate);
+    }
+
     triggerAsyncUpdate();
 }
 
@@ -67,22 +289,48 @@ void View::handleAsyncUpdate()
 
 void View::updateEverything()
 {
-    if (updateLayout())
-        recalculateLayoutToCurrentBounds();
-
+    // Elements must be updated before the layout, since this
+    // is where the style properties are resolved.
     updateElementIfNeeded();
 
-    updateChildren();
+    // Layout computation is skipped if nothing has changed.
+    updateLayout();
+    recalculateLayoutToCurrentBounds();
+
+    // There is no need to repaint the view here: the elements repaint
+    // themselves when their appearance changes, as well as the
+    // components when moved or resized.
+}
+
+void View::handleFrameTick()
+{
+    if (!resizePending)
+        return;
+
+    if (resizeMode == ResizeMode::scaled && Time::getMillisecondCounter() - lastResizeTime < kResizeSettleTimeMs)
+        return;
 
-    // Housekeeping: removing unreferenced elements from the stash.
-    context.getElementsFactory().clearUnreferencedStashedElements();
+    resizePending = false;
+    resizeSnapshot = {};
 
+    recalculateLayoutToCurrentBounds();
+    updateGradientToComponentSize();
     repaint();
 }
 
 void View::recalculateLayoutToCurrentBounds()
 {
-    recalculateLayout(static_cast<float>(getWidth()), static_cast<float>(getHeight()));
+    laidOutBounds = getLocalBounds();
+
+    const auto width{ static_cast<float>(getWidth()) };
+    const auto height{ static_cast<float>(getHeight()) };
+
+    if (asyncLayout != nullptr) {
+        if (auto snapshot{ createLayoutSnapshot(width, height) })
+            asyncLayout->request(std::move(snapshot));
+    } else {
+        recalculateLayout(width, height);
+    }
 }
 
 //==============================================================================
@@ -98,8 +346,10 @@ JSValue View::js_createElement(JSContext* ctx, JSValueConst self, int argc, JSVa
         JS_FreeCString(ctx, str);
 
         if (auto child{ view->context.getElementsFactory().createElement(elementTag) }) {
+            // The JS object must exist before stashing the element.
+            auto jsChild{ child->duplicateJSValue() };
             child->stash();
-            return child->duplicateJSValue();
+            return jsChild;
         }
 
         return JS_NULL;
@@ -3,6 +3,11 @@ namespace vitro {
 /** The top-most view container.
 
     The view must be the top-most element of the UI hierarchy.
+
+    Attributes:
+        asynclayout     Compute the layout on a worker thread.
+        resizemode      How the layout follows the view resizing (immediate, coalesced, scaled).
+        paintflashing   Tint the repainted regions (for debugging).
 */
 
 class View : public ComponentElementWithBackground,
@@ -12,6 +17,14 @@ class View : public ComponentElementWithBackground,
 {
 public:
 
+    /** Defines how the layout follows the view resizing. */
+    enum class ResizeMode
+    {
+        immediate,  ///< Layout is recalculated on each resize.
+        coalesced,  ///< Layout is recalculated once per display frame for the latest size.
+        scaled      ///< Last rendered view is scaled until the resizing stops.
+    };
+
     const static juce::Identifier tag;  // <View>
 
     static JSClassID jsClassID;
@@ -31,11 +44,45 @@ public:
     */
     void exposeToJS();
 
+    /** Enable or disable the off-thread layout computation.
+
+        When enabled, the layout is computed on a worker thread over a snapshot
+        of the layout nodes, and the results are applied to the components
+        asynchronously on the message thread. A layout result is dropped if
+        a newer computation has been requested in the meantime.
+
+        This is meant for very large views, where the layout computation
+        would otherwise block the message thread.
+    */
+    void setAsyncLayoutEnabled(bool shouldBeEnabled);
+
+    bool isAsyncLayoutEnabled() const { return asyncLayout != nullptr; }
+
+    /** Assign the view resize mode.
+
+        When a window is being resized interactively, the resize events usually come
+        far more often than the screen refreshes. The coalesced and scaled modes
+        defer the layout recalculation, skipping the intermediate sizes.
+    */
+    void setResizeMode(ResizeMode mode);
+
+    ResizeMode getResizeMode() const { return resizeMode; }
+
+    /** Enable tinting of the repainted regions.
+
+        This is a debugging aid to check which parts of the view
+        get repainted on the updates.
+    */
+    void setPaintFlashingEnabled(bool shouldBeEnabled);
+
+    bool isPaintFlashingEnabled() const { return paintFlashing; }
+
     static void registerJSPrototype(JSContext* jsCtx, JSValue prototype);
 
     // juce::Component
     void resized() override;
     void paint(juce::Graphics& g) override;
+    void paintOverChildren(juce::Graphics& g) override;
 
 protected:
 
@@ -44,6 +91,8 @@ protected:
 
 private:
 
+    class AsyncLayout;
+
     // juce::AsyncUpdater
     void handleAsyncUpdate() override;
 
@@ -51,11 +100,30 @@ private:
 
     void recalculateLayoutToCurrentBounds();
 
+    // Apply the deferred resize on a display frame.
+    void handleFrameTick();
+
     // JavaScript methods and properties
     static JSValue js_createElement(JSContext* ctx, JSValueConst self, int argc, JSValueConst* arg);
     static JSValue js_isDragAndDropActive(JSContext* ctx, JSValueConst self, int argc, JSValueConst* arg);
 
     juce::Colour backgroundColour{};
+
+    std::unique_ptr<AsyncLayout> asyncLayout{};
+
+    ResizeMode resizeMode{ ResizeMode::immediate };
+    std::unique_ptr<juce::VBlankAttachment> frameTick{};
+    bool resizePending{ false };
+    juce::uint32 lastResizeTime{};
+
+    // Size the layout has been computed for.
+    juce::Rectangle<int> laidOutBounds{};
+
+    // Last rendered view shown while resizing in scaled mode.
+    juce::Image resizeSnapshot{};
+
+    bool paintFlashing{ false };
+    float paintFlashingHue{};
 };
 
 } // namespace vitro
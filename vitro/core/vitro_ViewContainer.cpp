@@ -2,6 +2,8 @@ namespace vitro {
 
 ViewContainer::ViewContainer()
 {
+    // Prepare the context to be used when loading the UI.
+    ContextPool::getInstance()->prepare();
 }
 
 ViewContainer::~ViewContainer()
@@ -43,7 +45,7 @@ void ViewContainer::loadFromResource(const String& xmlLocation,
     // Delete the view before the context
     view.reset();
 
-    context = std::make_unique<vitro::Context>();
+    context = ContextPool::getInstance()->acquire();
 
     listeners.call(&Listener::onContextCreated, context.get());
 
@@ -59,6 +61,9 @@ void ViewContainer::loadFromResource(const String& xmlLocation,
 
         stylesheet.clear();
         stylesheet.populateFromString(loader.loadText(cssLocation), styleImporter);
+
+        // Start decoding the images before the elements request them.
+        loader.prefetchImages(stylesheet.getPropertyValues(attr::css::background_image));
     }
 
     // Create a new view before evaluating the script
@@ -83,6 +88,9 @@ void ViewContainer::loadFromResource(const String& xmlLocation,
 
     // Need to call resized so that the new view gets adjusted to the container
     resized();
+
+    // The next context is prepared once the UI has been loaded.
+    ContextPool::getInstance()->prepare();
 }
 
 void ViewContainer::resized()
@@ -36,6 +36,10 @@ public:
 
         This will reset the current view and the context, and create
         new ones loading the UI definition from the specified resources.
+        The new context is taken from the shared pool of prepared contexts,
+        which then prepares the next one once the UI has been loaded.
+
+        @see ContextPool
     */
     void loadFromResource(const juce::String& xmlLocation,
                           const juce::String& cssLocation = "",
@@ -407,6 +407,22 @@ const var& Stylesheet::getProperty(const Identifier& name, const ValueTree& tree
     return voidVar;
 }
 
+StringArray Stylesheet::getPropertyValues(const Identifier& name) const
+{
+    StringArray values{};
+
+    for (const auto& style : styles) {
+        if (style.hasProperty(name)) {
+            const auto& value{ style.getProperty(name) };
+
+            if (!value.isVoid())
+                values.addIfNotAlreadyThere(value.toString());
+        }
+    }
+
+    return values;
+}
+
 void Stylesheet::populateFromString(const String& text, const ImportFunction& importFunction)
 {
     CSSParser parser(*this);
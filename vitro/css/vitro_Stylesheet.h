@@ -193,6 +193,9 @@ public:
 
     const juce::var& getProperty(const juce::Identifier& name, const juce::ValueTree& tree) const;
 
+    /** Returns all the distinct values of a property across the styles of this stylesheet. */
+    juce::StringArray getPropertyValues(const juce::Identifier& name) const;
+
     const juce::NamedValueSet& getMacroDefinitions() const { return macroDefinitions; }
     juce::NamedValueSet& getMacroDefinitions() { return macroDefinitions; }
 
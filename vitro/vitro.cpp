@@ -4,6 +4,10 @@
 
 #include "vitro.h"
 
+#if VITRO_ENABLE_LAYOUT_PROFILER
+#   define YG_ENABLE_EVENTS
+#endif
+
 #include "yoga/log.cpp"
 #include "yoga/Utils.cpp"
 #include "yoga/YGConfig.cpp"
@@ -23,12 +27,22 @@ using namespace juce;
 #include "css/vitro_CSSParser.cpp"
 
 #include "core/vitro_Utils.cpp"
+#include "core/vitro_ImageCache.cpp"
 #include "core/vitro_Loader.cpp"
 #include "core/vitro_Context.cpp"
+#include "core/vitro_ContextPool.cpp"
 #include "core/vitro_Attributes.cpp"
 #include "core/vitro_LookAndFeel.cpp"
+#include "core/vitro_TextMetrics.cpp"
+#include "core/vitro_LayoutNodePool.cpp"
+#include "core/vitro_LayerCache.cpp"
+#include "core/vitro_DrawableCache.cpp"
+#include "core/vitro_ShadowCache.cpp"
+#include "core/vitro_BytecodeCache.cpp"
+#include "core/vitro_AtomCache.cpp"
 #include "core/vitro_Script.cpp"
 #include "core/vitro_Style.cpp"
+#include "core/vitro_Template.cpp"
 #include "core/vitro_Element.cpp"
 #include "core/vitro_ElementsFactory.cpp"
 #include "core/vitro_StyledElement.cpp"
@@ -45,8 +59,17 @@ using namespace juce;
 #include "widgets/vitro_Svg.cpp"
 #include "widgets/vitro_TextEditor.cpp"
 #include "widgets/vitro_ScrollArea.cpp"
+#include "widgets/vitro_VirtualList.cpp"
 #include "widgets/vitro_ComboBox.cpp"
 #include "widgets/vitro_MenuBar.cpp"
 #include "widgets/vitro_CodeEditor.cpp"
 #include "widgets/vitro_OpenGLView.cpp"
 #include "widgets/vitro_MidiKeyboard.cpp"
+
+#if VITRO_ENABLE_BENCHMARKS
+#   include "benchmarks/vitro_Benchmark.h"
+#   include "benchmarks/vitro_JSObjectBenchmark.cpp"
+#   include "benchmarks/vitro_LayoutNodePoolBenchmark.cpp"
+#   include "benchmarks/vitro_BackgroundBenchmark.cpp"
+#   include "benchmarks/vitro_ContextPoolBenchmark.cpp"
+#endif
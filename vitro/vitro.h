@@ -22,7 +22,35 @@
 
 #define VITRO_H_INCLUDED
 
+//==============================================================================
+/** Config: VITRO_ENABLE_LAYOUT_PROFILER
+    Enables collecting the per-element layout engine statistics.
+    This subscribes to the Yoga layout events, which has some runtime cost.
+
+    @see Instrumentation::elementLayouts
+*/
+#ifndef VITRO_ENABLE_LAYOUT_PROFILER
+#   define VITRO_ENABLE_LAYOUT_PROFILER 0
+#endif
+
+/** Config: VITRO_ENABLE_BENCHMARKS
+    Compiles the performance benchmarks, which are registered as unit tests
+    of the "vitro-benchmarks" category. These should be run in release builds.
+
+    @see Benchmark
+*/
+#ifndef VITRO_ENABLE_BENCHMARKS
+#   define VITRO_ENABLE_BENCHMARKS 0
+#endif
+
+#include <array>
+#include <atomic>
+#include <functional>
+#include <list>
 #include <optional>
+#include <typeinfo>
+#include <unordered_map>
+#include <unordered_set>
 
 #include <juce_core/juce_core.h>
 #include <juce_data_structures/juce_data_structures.h>
@@ -48,13 +76,24 @@ using namespace choc::javascript::quickjs;
 #include "css/vitro_CSSParser.h"
 
 #include "core/vitro_Utils.h"
+#include "core/vitro_ImageCache.h"
 #include "core/vitro_Loader.h"
 #include "core/vitro_Attributes.h"
 #include "core/vitro_LookAndFeel.h"
+#include "core/vitro_Instrumentation.h"
+#include "core/vitro_TextMetrics.h"
+#include "core/vitro_LayoutNodePool.h"
+#include "core/vitro_LayerCache.h"
+#include "core/vitro_DrawableCache.h"
+#include "core/vitro_ShadowCache.h"
+#include "core/vitro_BytecodeCache.h"
+#include "core/vitro_AtomCache.h"
 #include "core/vitro_Element.h"
 #include "core/vitro_Context.h"
+#include "core/vitro_ContextPool.h"
 #include "core/vitro_Script.h"
 #include "core/vitro_Style.h"
+#include "core/vitro_Template.h"
 #include "core/vitro_ElementsFactory.h"
 #include "core/vitro_StyledElement.h"
 #include "core/vitro_LayoutElement.h"
@@ -70,6 +109,7 @@ using namespace choc::javascript::quickjs;
 #include "widgets/vitro_Svg.h"
 #include "widgets/vitro_TextEditor.h"
 #include "widgets/vitro_ScrollArea.h"
+#include "widgets/vitro_VirtualList.h"
 #include "widgets/vitro_ComboBox.h"
 #include "widgets/vitro_MenuBar.h"
 #include "widgets/vitro_CodeEditor.h"
@@ -16,12 +16,17 @@ TextButton::TextButton(Context& ctx)
     registerStyleProperty(attr::css::border_color);
     registerStyleProperty(attr::css::border_radius);
     registerStyleProperty(attr::css::border_width);
+
+    enableIntrinsicSize();
 }
 
 void TextButton::update()
 {
     ButtonBase::update();
 
+    if (getAttributeChanged(attr::text).first)
+        invalidateIntrinsicSize();
+
     // toggle
     if (const auto&& [changed, prop]{ getStylePropertyChanged(attr::css::toggle) }; !prop.isVoid())
         juce::TextButton::setClickingTogglesState(prop);
@@ -71,6 +76,18 @@ void TextButton::resized()
     updateGradientToComponentSize();
 }
 
+juce::Point<float> TextButton::measureContent(float, float availableHeight)
+{
+    // Button font depends on its height, so we measure for the height given
+    // by the layout if any. The width follows juce::TextButton::getBestWidthForHeight.
+    const auto height{ std::isfinite(availableHeight) ? availableHeight : defaultHeight };
+    const auto font{ getLookAndFeel().getTextButtonFont(*this, juce::roundToInt(height)) };
+
+    const auto textWidth{ context.getTextMetrics().getStringWidth(font, getButtonText()) };
+
+    return { textWidth + height, height };
+}
+
 bool TextButton::hasGradientBackground() const
 {
     return static_cast<bool>(gradient);
@@ -116,10 +133,11 @@ JSClassID DrawableButton::jsClassID = 0;
 
 const Identifier DrawableButton::tag("DrawableButton");
 
-std::unique_ptr<juce::Drawable> DrawableButton::loadDrawable(Loader& loader, const String& location)
+std::unique_ptr<juce::Drawable> DrawableButton::loadDrawable(const String& location)
 {
-    if (auto xml{ loader.loadXML(location) })
-        return juce::Drawable::createFromSVG(*xml);
+    // Cached drawables are shared, so the button gets its own copy.
+    if (auto drawable{ context.getDrawableCache().getDrawable(context.getLoader(), location) })
+        return drawable->createCopy();
 
     return nullptr;
 }
@@ -168,31 +186,29 @@ void DrawableButton::update()
     std::unique_ptr<juce::Drawable> downOn{};
     std::unique_ptr<juce::Drawable> disabledOn{};
 
-    auto& loader{ context.getLoader() };
-
     if (auto&& [changed, prop]{ getStylePropertyChanged(attr::css::image_normal) }; changed)
-        normal = loadDrawable(loader, prop.toString());
+        normal = loadDrawable(prop.toString());
 
     if (auto&& [changed, prop]{ getStylePropertyChanged(attr::css::image_over) }; changed)
-        over = loadDrawable(loader, prop.toString());
+        over = loadDrawable(prop.toString());
 
     if (auto&& [changed, prop]{ getStylePropertyChanged(attr::css::image_down) }; changed)
-        down = loadDrawable(loader, prop.toString());
+        down = loadDrawable(prop.toString());
 
     if (auto&& [changed, prop]{ getStylePropertyChanged(attr::css::image_disabled) }; changed)
-        disabled = loadDrawable(loader, prop.toString());
+        disabled = loadDrawable(prop.toString());
 
     if (auto&& [changed, prop]{ getStylePropertyChanged(attr::css::image_normal_on) }; changed)
-        normalOn = loadDrawable(loader, prop.toString());
+        normalOn = loadDrawable(prop.toString());
 
     if (auto&& [changed, prop]{ getStylePropertyChanged(attr::css::image_over_on) }; changed)
-        overOn = loadDrawable(loader, prop.toString());
+        overOn = loadDrawable(prop.toString());
 
     if (auto&& [changed, prop]{ getStylePropertyChanged(attr::css::image_down_on) }; changed)
-        downOn = loadDrawable(loader, prop.toString());
+        downOn = loadDrawable(prop.toString());
 
     if (auto&& [changed, prop]{getStylePropertyChanged(attr::css::image_disabled_on) }; changed)
-        disabledOn = loadDrawable (loader, prop.toString());
+        disabledOn = loadDrawable(prop.toString());
 
     if (normal != nullptr) {
         juce::DrawableButton::setImages(normal.get(), over.get(), down.get(), disabled.get(),
@@ -62,6 +62,7 @@ public:
 /** Text button.
 
     This element is a text button, which is equivalent to juce::TextButton.
+    Unless defined by the style, the button is sized to fit its text.
 
     Style properties:
         toggle
@@ -103,6 +104,14 @@ public:
     static constexpr float defaultBorderRadius = 6.0f;
     static constexpr float defaultBorderWidth = 1.0f;
 
+    /** Button height used when measuring the text if not defined by the layout. */
+    static constexpr float defaultHeight = 24.0f;
+
+protected:
+
+    // vitro::LayoutElement
+    juce::Point<float> measureContent(float availableWidth, float availableHeight) override;
+
 private:
 
     void updateGradientToComponentSize();
@@ -191,7 +200,7 @@ public:
     void update() override;
 
 private:
-    static std::unique_ptr<juce::Drawable> loadDrawable(Loader& loader, const juce::String& location);
+    std::unique_ptr<juce::Drawable> loadDrawable(const juce::String& location);
 };
 
 } // namespace vitro
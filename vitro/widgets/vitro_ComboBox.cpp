@@ -7,6 +7,14 @@ const Identifier ComboBox::tagHeading("heading");
 const Identifier ComboBox::tagSeparator("separator");
 const Identifier ComboBox::tagItem("item");
 
+namespace {
+    constexpr float kDefaultComboBoxHeight = 24.0f;
+
+    // Space taken by the arrow and the text label border,
+    // as positioned by juce::LookAndFeel_V4::positionComboBoxText.
+    constexpr float kComboBoxTextMargin = 42.0f;
+}
+
 ComboBox::ComboBox(Context& ctx)
     : ComponentElement(ComboBox::tag, ctx)
 {
@@ -20,6 +28,8 @@ ComboBox::ComboBox(Context& ctx)
     registerStyleProperty(attr::css::text_align);
 
     juce::ComboBox::addListener(this);
+
+    enableIntrinsicSize();
 }
 
 void ComboBox::update()
@@ -29,6 +39,7 @@ void ComboBox::update()
     if (itemsUpdatePending) {
         populateItems();
         itemsUpdatePending = false;
+        invalidateIntrinsicSize();
     }
 
     setColourFromStyleProperty(juce::ComboBox::textColourId,       attr::css::color);
@@ -57,11 +68,15 @@ void ComboBox::update()
         getLookAndFeel().setColour(juce::PopupMenu::highlightedBackgroundColourId, parseColourFromString(val.toString()));
 
 
-    if (auto&& [changed, val]{ getAttributeChanged(attr::emptytext) }; changed)
+    if (auto&& [changed, val]{ getAttributeChanged(attr::emptytext) }; changed) {
         setTextWhenNoChoicesAvailable(val.toString());
+        invalidateIntrinsicSize();
+    }
 
-    if (auto&& [changed, val]{ getAttributeChanged(attr::noselectiontext) }; changed)
+    if (auto&& [changed, val]{ getAttributeChanged(attr::noselectiontext) }; changed) {
         setTextWhenNothingSelected(val.toString());
+        invalidateIntrinsicSize();
+    }
 
     if (auto&& [changed, val]{ getAttributeChanged(attr::selectedid) }; changed && !val.isVoid()) {
         const int newSelectedId{ val };
@@ -72,6 +87,26 @@ void ComboBox::update()
 
 }
 
+juce::Point<float> ComboBox::measureContent(float, float availableHeight)
+{
+    const auto height{ std::isfinite(availableHeight) ? availableHeight : kDefaultComboBoxHeight };
+
+    // The combo box font depends on its height (see juce::LookAndFeel_V4::getComboBoxFont),
+    // so we measure for the height given by the layout if any.
+    auto font{ getLookAndFeel().getComboBoxFont(*this) };
+    font.setHeight(juce::jmin(16.0f, height * 0.85f));
+
+    auto& metrics{ context.getTextMetrics() };
+
+    float textWidth{ juce::jmax(metrics.getStringWidth(font, getTextWhenNothingSelected()),
+                                metrics.getStringWidth(font, getTextWhenNoChoicesAvailable())) };
+
+    for (int i = 0; i < getNumItems(); ++i)
+        textWidth = juce::jmax(textWidth, metrics.getStringWidth(font, getItemText(i)));
+
+    return { textWidth + kComboBoxTextMargin, height };
+}
+
 void ComboBox::populateItems()
 {
     juce::ComboBox::clear(juce::dontSendNotification);
@@ -6,6 +6,7 @@ namespace vitro {
 
     The items of the ComboBox are defined via the child <item> elements.
     Additional child elements are <heading> and <separator>.
+    Unless defined by the style, the combo box is sized to fit its longest item.
 
     Attributes:
         emptytext
@@ -46,6 +47,9 @@ protected:
     // vitro::Element
     void update() override;
 
+    // vitro::LayoutElement
+    juce::Point<float> measureContent(float availableWidth, float availableHeight) override;
+
 private:
 
     void populateItems();
@@ -15,6 +15,8 @@ Label::Label(Context& ctx)
     registerStyleProperty(attr::css::font_style);
     registerStyleProperty(attr::css::font_size);
     registerStyleProperty(attr::css::font_kerning);
+
+    enableIntrinsicSize();
 }
 
 void Label::update()
@@ -37,6 +39,20 @@ void Label::update()
         juce::Label::setJustificationType(prop.isVoid() ? Justification::left
                                                         : parseJustificationFromString(prop.toString()));
     }
+
+    if (getAttributeChanged(attr::text).first || isFontStylePropertyChanged())
+        invalidateIntrinsicSize();
+}
+
+juce::Point<float> Label::measureContent(float, float)
+{
+    const auto font{ getFont() };
+    const auto border{ getBorderSize() };
+
+    const auto textWidth{ context.getTextMetrics().getStringWidth(font, getText()) };
+
+    return { textWidth + (float)border.getLeftAndRight(),
+             font.getHeight() + (float)border.getTopAndBottom() };
 }
 
 } // namespace vitro
@@ -3,6 +3,7 @@ namespace vitro {
 /** Text label.
 
     This widget corresponds to juce::Label.
+    Unless defined by the style, the label is sized to fit its text.
 
     Attributes:
         text    Label text
@@ -37,6 +38,9 @@ protected:
     // vitro::Element
     void update() override;
 
+    // vitro::LayoutElement
+    juce::Point<float> measureContent(float availableWidth, float availableHeight) override;
+
 };
 
 } // namespace vitro
@@ -95,6 +95,14 @@ void OpenGLView::RenderPass::addUniform(std::unique_ptr<Uniform>&& uniform)
     uniforms.push_back(std::move(uniform));
 }
 
+void OpenGLView::RenderPass::setUniformValues(const juce::String& uniformName, const std::vector<float>& values)
+{
+    for (auto&& uniform : uniforms) {
+        if (uniform->getName() == uniformName)
+            uniform->setValueFromFloats(values.data(), values.size());
+    }
+}
+
 void OpenGLView::RenderPass::render()
 {
     using namespace juce::gl;
@@ -187,6 +195,22 @@ void OpenGLView::Uniform::setValue(const juce::var& val)
         return;
     }
 
+    // Float32Array from the script
+    if (auto* buffer{ dynamic_cast<js::SharedBuffer*>(val.getObject()) }) {
+        if (buffer->getType() == js::SharedBuffer::Type::Float32Array)
+            setValueFromFloats(buffer->getFloats(), buffer->getNumFloats());
+        else
+            DBG("Uniform " << name << " value must be a Float32Array");
+
+        return;
+    }
+
+    // The type of the binary data values is unknown
+    if (val.isBinaryData()) {
+        DBG("Uniform " << name << " value must be a Float32Array");
+        return;
+    }
+
     switch (type) {
     case Type::Invalid:
         break;
@@ -273,6 +297,36 @@ void OpenGLView::Uniform::setValueFromString(const juce::String& str)
     }
 }
 
+void OpenGLView::Uniform::setValueFromFloats(const float* values, size_t numValues)
+{
+    switch (type) {
+    case Type::Invalid:
+        break;
+    case Type::Int:
+        if (numValues > 0)
+            value.intValue = (int)values[0];
+        break;
+    case Type::Float:
+        if (numValues > 0)
+            value.floatValue = values[0];
+        break;
+    case Type::Vec2:
+    case Type::Vec3:
+    case Type::Vec4:
+        std::copy(values, values + jmin(numValues, (size_t)4), value.vecValue);
+        break;
+    case Type::FloatVec:
+        floatVec.assign(values, values + numValues);
+        break;
+    case Type::Texture:
+        // Textures are referenced by name only
+        break;
+    default:
+        jassertfalse;
+        break;
+    }
+}
+
 void OpenGLView::Uniform::setTexture(const juce::String& textureName)
 {
     jassert(type == Type::Texture);
@@ -509,6 +563,19 @@ void OpenGLView::populateItems()
     }, false);
 }
 
+void OpenGLView::applyPendingUniformValues(bool applyAll)
+{
+    for (auto&& [name, entry] : pendingUniformValues) {
+        if (!entry.pending && !applyAll)
+            continue;
+
+        for (auto&& pass : renderPasses)
+            pass->setUniformValues(name, entry.values);
+
+        entry.pending = false;
+    }
+}
+
 void OpenGLView::updateState()
 {
     state.lock();
@@ -549,6 +616,22 @@ void OpenGLView::newOpenGLContextCreated()
     openGLContext.extensions.glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
 }
 
+void OpenGLView::setUniformValues(const juce::String& name, const float* values, size_t numValues)
+{
+    std::scoped_lock lock{ updateMutex };
+
+    auto& entry{ pendingUniformValues[name] };
+    entry.values.assign(values, values + numValues);
+    entry.pending = true;
+}
+
+void OpenGLView::registerJSPrototype(JSContext* ctx, JSValue prototype)
+{
+    ComponentElement::registerJSPrototype(ctx, prototype);
+
+    registerJSMethod(ctx, prototype, "setUniform", &js_setUniform);
+}
+
 unsigned int OpenGLView::findTextureID(const String& name) const
 {
     if (const auto it{ textures.find(name) }; it != textures.end())
@@ -597,10 +680,15 @@ void OpenGLView::renderOpenGL()
     {
         std::scoped_lock lock{ updateMutex };
 
+        // Newly populated uniforms must get all the assigned values.
+        const bool repopulated{ itemsUpdatePending };
+
         if (itemsUpdatePending) {
             populateItems();
             itemsUpdatePending = false;
         }
+
+        applyPendingUniformValues(repopulated);
     }
 
     glEnable(GL_DEBUG_OUTPUT);
@@ -673,4 +761,56 @@ void OpenGLView::valueTreeChildRemoved(juce::ValueTree& tree, juce::ValueTree& c
     itemsUpdatePending = true;
 }
 
+//==============================================================================
+
+JSValue OpenGLView::js_setUniform(JSContext* ctx, JSValueConst self, int argc, JSValueConst* arg)
+{
+    if (argc != 2)
+        return JS_ThrowSyntaxError(ctx, "setUniform expects two arguments: uniform's name and value");
+
+    auto view{ Context::getJSNativeObject<OpenGLView>(self) };
+
+    if (view == nullptr)
+        return JS_UNDEFINED;
+
+    const auto name{ view->context.getAtomCache().getIdentifier(ctx, arg[0]) };
+
+    if (!name.isValid())
+        return JS_ThrowTypeError(ctx, "setUniform expects a non-empty uniform name");
+
+    // Float32Array is read in place
+    if (size_t numValues{}; const auto* data{ js::getFloat32ArrayData(ctx, arg[1], numValues) }) {
+        view->setUniformValues(name.toString(), data, numValues);
+        return JS_UNDEFINED;
+    }
+
+    std::vector<float> values{};
+
+    if (JS_IsObject(arg[1])) {
+        // Arrays and other typed arrays are converted element by element.
+        auto lengthValue{ JS_GetPropertyStr(ctx, arg[1], "length") };
+        uint32_t length{};
+        JS_ToUint32(ctx, &length, lengthValue);
+        JS_FreeValue(ctx, lengthValue);
+
+        values.reserve(length);
+
+        for (uint32_t i = 0; i < length; ++i) {
+            auto item{ JS_GetPropertyUint32(ctx, arg[1], i) };
+            double x{};
+            JS_ToFloat64(ctx, &x, item);
+            JS_FreeValue(ctx, item);
+            values.push_back((float)x);
+        }
+    } else {
+        double x{};
+        JS_ToFloat64(ctx, &x, arg[1]);
+        values.push_back((float)x);
+    }
+
+    view->setUniformValues(name.toString(), values.data(), values.size());
+
+    return JS_UNDEFINED;
+}
+
 } // namespace vitro
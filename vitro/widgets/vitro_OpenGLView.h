@@ -19,6 +19,10 @@ namespace vitro {
 
     Attributes
         fps
+
+    Uniform values can be assigned from C++ via setUniformValues, or from
+    JavaScript via setUniform(name, value), where the value can be a number,
+    an array, or a Float32Array which is read without conversion.
 */
 class OpenGLView : public vitro::ComponentElement,
                    public juce::Component,
@@ -64,9 +68,20 @@ public:
 
     State& getState() { return state; }
 
+    /** Assign uniform variable values.
+
+        This assigns the values to all the uniforms with the given name.
+        The values get copied and then applied on the rendering thread
+        on the next render pass, without being converted to juce::var.
+        Scalar and vec uniforms take the leading values only.
+    */
+    void setUniformValues(const juce::String& name, const float* values, size_t numValues);
+
     // juce::Component
     void resized() override;
 
+    static void registerJSPrototype(JSContext* ctx, JSValue prototype);
+
 protected:
 
     // vitro::Element
@@ -94,6 +109,7 @@ private:
         bool hasTargetFrameBuffer() const;
         unsigned int getTextureID() const;
         void addUniform(std::unique_ptr<Uniform>&& uniform);
+        void setUniformValues(const juce::String& uniformName, const std::vector<float>& values);
         void render();
 
         const OpenGLView& getOpenGLView() const { return openGLView; }
@@ -145,6 +161,7 @@ private:
 
         void setValue(const juce::var& val);
         void setValueFromString(const juce::String& str);
+        void setValueFromFloats(const float* values, size_t numValues);
         void setTexture(const juce::String& textureName);
 
         /** Trigger uniform value update.
@@ -195,6 +212,12 @@ private:
     void populateShaderUniform(RenderPass& renderPass, const Element::Ptr& elem);
     void populateItems();
 
+    /** Apply the values assigned via setUniformValues.
+
+        @note This must be called on the render thread with the update mutex locked.
+    */
+    void applyPendingUniformValues(bool applyAll);
+
     /** Capture the state. */
     void updateState();
 
@@ -218,9 +241,22 @@ private:
     std::vector<std::unique_ptr<RenderPass>> renderPasses{};
     std::map<juce::String, std::unique_ptr<juce::OpenGLTexture>> textures{};
 
+    // JavaScript methods
+    static JSValue js_setUniform(JSContext* ctx, JSValueConst self, int argc, JSValueConst* arg);
+
+    struct PendingUniformValues final
+    {
+        std::vector<float> values{};
+        bool pending{};
+    };
+
     std::mutex updateMutex{};
     std::atomic<bool> itemsUpdatePending{};
 
+    // Values assigned via setUniformValues, guarded by the updateMutex.
+    // The entries are kept to reuse the allocated vectors.
+    std::map<juce::String, PendingUniformValues> pendingUniformValues{};
+
     State state{};
 };
 
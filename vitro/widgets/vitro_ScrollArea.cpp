@@ -24,6 +24,17 @@ void ScrollArea::Updater::scrollBarMoved(juce::ScrollBar* bar, double newRangeSt
 
 //==============================================================================
 
+ScrollArea::Container::Container(ScrollArea& owner)
+    : scrollArea{ owner }
+{
+}
+
+void ScrollArea::Container::paint(juce::Graphics& g)
+{
+    // The content shadows are painted by its parent
+    scrollArea.paintChildrenShadows(g);
+}
+
 void ScrollArea::Container::childBoundsChanged(juce::Component* child)
 {
     setSize(child->getWidth(), child->getHeight());
@@ -33,7 +44,8 @@ void ScrollArea::Container::childBoundsChanged(juce::Component* child)
 
 ScrollArea::ScrollArea(Context& ctx)
     : ComponentElement(ScrollArea::tag, ctx),
-      scrollUpdater{ *this }
+      scrollUpdater{ *this },
+      container{ *this }
 {
     // Hide the viewport scroll bars but allow scrolling
     setScrollBarsShown(false, false, true, true);
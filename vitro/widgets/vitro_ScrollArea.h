@@ -62,8 +62,14 @@ private:
     class Container : public juce::Component
     {
     public:
+        Container(ScrollArea& owner);
+
         // juce::Component
+        void paint(juce::Graphics& g) override;
         void childBoundsChanged(juce::Component* child) override;
+
+    private:
+        ScrollArea& scrollArea;
     };
 
     void updateScrollBars();
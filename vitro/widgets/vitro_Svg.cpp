@@ -19,21 +19,43 @@ void Svg::forwardXmlElement(const juce::XmlElement& xml)
     }
 }
 
+void Svg::cloneFrom(const Element& other)
+{
+    ComponentElementWithBackground::cloneFrom(other);
+
+    // The drawable may have been populated from the inner XML,
+    // which is not preserved in the attributes.
+    if (auto* svg{ dynamic_cast<const Svg*>(&other) }) {
+        drawable = svg->drawable;
+        source = svg->source;
+    }
+}
+
 void Svg::paint(juce::Graphics& g)
 {
     ComponentElementWithBackground::paintBackground(g);
 
-    if (drawable != nullptr)
-        drawable->draw(g, 1.0f, scaleTransform);
+    if (drawable == nullptr)
+        return;
+
+    if (rasterize && source.isNotEmpty()) {
+        const auto pixelScale{ g.getInternalContext().getPhysicalPixelScaleFactor() };
+
+        const auto image{ context.getDrawableCache().getRasterImage(source, *drawable, scaleTransform,
+                                                                    { getWidth(), getHeight() }, pixelScale) };
+
+        if (image.isValid()) {
+            g.drawImageTransformed(image, AffineTransform::scale(1.0f / pixelScale));
+            return;
+        }
+    }
+
+    drawable->draw(g, 1.0f, scaleTransform);
 }
 
 void Svg::resized()
 {
     ComponentElementWithBackground::updateGradientToComponentSize();
-
-    if (drawable != nullptr)
-        drawable->setBounds(getLocalBounds());
-
     updateScaleTransform();
 }
 
@@ -41,28 +63,43 @@ void Svg::update()
 {
     ComponentElementWithBackground::update();
 
-    if (const auto&& [changed, val]{ getAttributeChanged(attr::src) }; changed)
+    bool shouldUpdateTransform{ false };
+
+    if (const auto&& [changed, val]{ getAttributeChanged(attr::src) }; changed) {
         populateFromXmlResource(val.toString());
+        shouldUpdateTransform = true;
+    }
 
-    if (const auto&& [changed, val]{ getAttributeChanged(attr::scale) }; changed)
-        scale = (float)val;
+    if (const auto&& [changed, val]{ getAttributeChanged(attr::scale) }; changed) {
+        scale = val.isVoid() ? 1.0f : (float)val;
+        shouldUpdateTransform = true;
+    }
+
+    if (const auto&& [changed, val]{ getAttributeChanged(attr::rasterize) }; changed)
+        rasterize = (bool)val;
+
+    if (shouldUpdateTransform)
+        updateScaleTransform();
 }
 
 void Svg::populateFromXml(const juce::XmlElement& svg)
 {
     drawable = Drawable::createFromSVG(svg);
+    source = {};
+    updateScaleTransform();
 }
 
 void Svg::populateFromXmlResource(const String& location)
 {
-    if (auto xml{ context.getLoader().loadXML(location) })
-        populateFromXml(*xml);
-    else
-        drawable.reset();
+    drawable = context.getDrawableCache().getDrawable(context.getLoader(), location);
+    source = drawable != nullptr ? location : String();
 }
 
 void Svg::updateScaleTransform()
 {
+    if (drawable == nullptr)
+        return;
+
     // Fit the SVG into the component's bounds
     const auto bounds{ drawable->getDrawableBounds() };
     const float scaleX{ bounds.getWidth() > 0 ? getWidth() / bounds.getWidth() : 1.0f };
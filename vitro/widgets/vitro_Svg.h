@@ -2,9 +2,18 @@ namespace vitro {
 
 /** An SVG drawable element.
 
+    The SVG loaded from the src location is shared with all
+    the other elements displaying the same source.
+    @see DrawableCache
+
+    With the rasterize attribute set the SVG gets rendered into a
+    cached bitmap, which is then reused by all the elements of the same
+    source and size. This is faster for the small static images like icons.
+
     Attributes:
         src
         scale
+        rasterize
 */
 class Svg : public ComponentElementWithBackground,
             public juce::Component
@@ -33,14 +42,21 @@ protected:
 
     // vitro::Element
     void update() override;
+    void cloneFrom(const Element& other) override;
 
     void populateFromXml(const juce::XmlElement& svg);
     void populateFromXmlResource(const juce::String& location);
     void updateScaleTransform();
 
     float scale{ 1.0f };
+    bool rasterize{ false };
     juce::AffineTransform scaleTransform{};
-    std::unique_ptr<juce::Drawable> drawable{};
+
+    // Drawable source location, empty when populated from the inner XML.
+    juce::String source{};
+
+    // The drawable may be shared, so it must never be modified.
+    DrawableCache::DrawablePtr drawable{};
 };
 
 } // namespace vitro
@@ -0,0 +1,365 @@
+namespace vitro {
+
+JSClassID VirtualList::jsClassID = 0;
+
+const Identifier VirtualList::tag("VirtualList");
+
+namespace {
+    constexpr float kDefaultRowHeight = 24.0f;
+    constexpr int kDefaultOverscan = 2;
+    constexpr int kDefaultScrollBarThickness = 8;
+}
+
+VirtualList::Container::Container(VirtualList& owner)
+    : list{ owner }
+{
+    setInterceptsMouseClicks(false, true);
+}
+
+void VirtualList::Container::paint(juce::Graphics& g)
+{
+    // Rows shadows are painted by their parent
+    list.paintChildrenShadows(g);
+}
+
+//==============================================================================
+
+VirtualList::VirtualList(Context& ctx)
+    : ComponentElement(VirtualList::tag, ctx),
+      container{ *this }
+{
+    setScrollBarsShown(true, false);
+    setScrollBarThickness(kDefaultScrollBarThickness);
+    setViewedComponent(&container, false);
+
+    registerStyleProperty(attr::css::row_height, kDefaultRowHeight);
+    registerStyleProperty(attr::css::thumb_color);
+    registerStyleProperty(attr::css::scrollbar_thickness);
+}
+
+void VirtualList::forwardXmlElement(const juce::XmlElement& xml)
+{
+    // xml here may represent this <VirtualList> element,
+    // in which case the row template is its first child.
+    const juce::XmlElement* templateXml{ &xml };
+
+    if (xml.getTagName() == VirtualList::tag.toString()) {
+        templateXml = nullptr;
+
+        for (auto* child : xml.getChildIterator()) {
+            if (!child->isTextElement()) {
+                templateXml = child;
+                break;
+            }
+        }
+    }
+
+    removeAllRows();
+
+    if (templateXml != nullptr)
+        rowTemplate = std::make_unique<juce::XmlElement>(*templateXml);
+    else
+        rowTemplate.reset();
+
+    updateVisibleRows();
+}
+
+void VirtualList::setModel(Model* newModel)
+{
+    model = newModel;
+    refresh();
+}
+
+int VirtualList::getNumRows() const
+{
+    if (model != nullptr)
+        return model->getNumRows();
+
+    if (const auto* items{ getAttribute(attr::items).getArray() })
+        return items->size();
+
+    return juce::jmax(0, (int)getAttribute(attr::count));
+}
+
+void VirtualList::refresh()
+{
+    for (auto& row : rows)
+        row.index = -1;
+
+    updateVisibleRows();
+}
+
+void VirtualList::scrollToRow(int index)
+{
+    const auto rowHeight{ getRowHeight() };
+    const auto rowTop{ juce::roundToInt(index * rowHeight) };
+    const auto rowBottom{ juce::roundToInt((index + 1) * rowHeight) };
+
+    if (rowTop < getViewPositionY())
+        setViewPosition(getViewPositionX(), rowTop);
+    else if (rowBottom > getViewPositionY() + getViewHeight())
+        setViewPosition(getViewPositionX(), rowBottom - getViewHeight());
+}
+
+void VirtualList::resized()
+{
+    juce::Viewport::resized();
+
+    // Rows width follows the list width, so all of them must be replaced.
+    refresh();
+}
+
+void VirtualList::visibleAreaChanged(const juce::Rectangle<int>&)
+{
+    updateVisibleRows();
+}
+
+void VirtualList::registerJSPrototype(JSContext* ctx, JSValue prototype)
+{
+    ComponentElement::registerJSPrototype(ctx, prototype);
+
+    registerJSMethod(ctx, prototype, "refresh",     &js_refresh);
+    registerJSMethod(ctx, prototype, "scrollToRow", &js_scrollToRow);
+}
+
+void VirtualList::update()
+{
+    ComponentElement::update();
+
+    setColourFromStyleProperty(getVerticalScrollBar(), juce::ScrollBar::thumbColourId, attr::css::thumb_color);
+
+    if (auto&& [changed, prop]{ getStylePropertyChanged(attr::css::scrollbar_thickness) }; changed)
+        setScrollBarThickness(prop.isVoid() ? kDefaultScrollBarThickness : (int)prop);
+
+    bool shouldRefresh{ false };
+
+    if (auto&& [changed, val]{ getAttributeChanged(attr::overscan) }; changed) {
+        overscan = val.isVoid() ? kDefaultOverscan : juce::jmax(0, (int)val);
+        shouldRefresh = true;
+    }
+
+    shouldRefresh = shouldRefresh
+                 || isStylePropertyChanged(attr::css::row_height)
+                 || getAttributeChanged(attr::count).first
+                 || getAttributeChanged(attr::items).first
+                 || getAttributeChanged(attr::onbindrow).first;
+
+    if (shouldRefresh)
+        refresh();
+}
+
+void VirtualList::cloneFrom(const Element& other)
+{
+    ComponentElement::cloneFrom(other);
+
+    if (auto* list{ dynamic_cast<const VirtualList*>(&other) }) {
+        if (list->rowTemplate != nullptr)
+            rowTemplate = std::make_unique<juce::XmlElement>(*list->rowTemplate);
+    }
+}
+
+float VirtualList::getRowHeight() const
+{
+    const auto& prop{ getStyleProperty(attr::css::row_height) };
+    return prop.isVoid() ? kDefaultRowHeight : juce::jmax(1.0f, (float)prop);
+}
+
+void VirtualList::updateVisibleRows()
+{
+    // Resizing the container below will cause the visible area change,
+    // so we have to prevent the recursion here.
+    if (updatingRows || rowTemplate == nullptr)
+        return;
+
+    const juce::ScopedValueSetter<bool> scope(updatingRows, true);
+
+    numRows = getNumRows();
+
+    const auto rowHeight{ getRowHeight() };
+    const auto rowWidth{ getMaximumVisibleWidth() };
+
+    container.setSize(rowWidth, juce::roundToInt(numRows * rowHeight));
+
+    const auto viewTop{ (float)getViewPositionY() };
+    const auto viewHeight{ (float)getViewHeight() };
+
+    // Number of rows that may intersect the visible area
+    const int poolSize{ juce::jmin(numRows, (int)std::ceil(viewHeight / rowHeight) + 1 + 2 * overscan) };
+
+    if ((int)rows.size() != poolSize) {
+        while ((int)rows.size() > poolSize) {
+            removeChildElement(rows.back().element);
+            rows.pop_back();
+        }
+
+        while ((int)rows.size() < poolSize) {
+            auto row{ std::dynamic_pointer_cast<LayoutElement>(Element::createFromXml(context, *rowTemplate)) };
+
+            if (row == nullptr) {
+                DBG("VirtualList row template must be a layout element");
+                break;
+            }
+
+            addChildElement(row);
+            rows.push_back({ row, -1 });
+        }
+
+        // Rows to slots mapping depends on the pool size
+        for (auto& row : rows)
+            row.index = -1;
+    }
+
+    if (rows.empty())
+        return;
+
+    const int firstIndex{ juce::jmax(0, (int)(viewTop / rowHeight) - overscan) };
+    const int lastIndex{ juce::jmin(numRows, (int)((viewTop + viewHeight) / rowHeight) + 1 + overscan) };
+
+    for (int index = firstIndex; index < lastIndex; ++index) {
+        auto& row{ rows[(size_t)index % rows.size()] };
+
+        if (row.index == index)
+            continue;
+
+        row.index = index;
+
+        const juce::Rectangle<float> bounds{ 0.0f, index * rowHeight, (float)rowWidth, rowHeight };
+        row.element->setLayoutBoundsOverride(bounds);
+
+        // Place the component immediately, without waiting for the layout update.
+        if (auto componentElement{ std::dynamic_pointer_cast<ComponentElement>(row.element) })
+            componentElement->getComponent()->setBounds(bounds.toNearestInt());
+
+        bindRow(row);
+    }
+
+    for (auto& row : rows)
+        row.element->setAttribute(attr::visible, row.index >= firstIndex && row.index < lastIndex);
+}
+
+void VirtualList::removeAllRows()
+{
+    for (auto& row : rows) {
+        if (row.element->getParentElement().get() == this)
+            removeChildElement(row.element);
+    }
+
+    rows.clear();
+}
+
+void VirtualList::bindRow(Row& row)
+{
+    auto& element{ row.element };
+    element->setAttribute(attr::index, row.index);
+
+    if (model != nullptr) {
+        resetItemAttributes(row, {});
+        model->bindRow(element, row.index);
+        return;
+    }
+
+    var item{};
+
+    if (const auto* items{ getAttribute(attr::items).getArray() }) {
+        if (juce::isPositiveAndBelow(row.index, items->size()))
+            item = items->getReference(row.index);
+    }
+
+    std::vector<Identifier> itemAttributes{};
+
+    if (auto* obj{ item.getDynamicObject() }) {
+        for (const auto& prop : obj->getProperties()) {
+            element->setAttribute(prop.name, prop.value);
+            itemAttributes.push_back(prop.name);
+        }
+    } else if (!item.isVoid()) {
+        element->setAttribute(attr::text, item);
+        itemAttributes.push_back(attr::text);
+    }
+
+    resetItemAttributes(row, std::move(itemAttributes));
+
+    auto* jsCtx{ context.getJSContext() };
+
+    // The handler may replace its own attribute, so we keep a reference while calling it.
+    const auto func{ JS_DupValue(jsCtx, getAttributeFunction(attr::onbindrow)) };
+
+    if (JS_IsUndefined(func))
+        return;
+
+    JSValue args[] {
+        element->duplicateJSValue(),
+        JS_NewInt32(jsCtx, row.index),
+        js::varToJSValue(jsCtx, item)
+    };
+
+    int numArgs{ 3 };
+
+    // A script attribute receives the binding as its event object.
+    if (getAttribute(attr::onbindrow).isString()) {
+        auto event{ JS_NewObject(jsCtx) };
+        JS_SetPropertyStr(jsCtx, event, "row", args[0]);
+        JS_SetPropertyStr(jsCtx, event, "index", args[1]);
+        JS_SetPropertyStr(jsCtx, event, "item", args[2]);
+
+        args[0] = event;
+        args[1] = JS_UNDEFINED;
+        args[2] = JS_UNDEFINED;
+        numArgs = 1;
+    }
+
+    auto ret{ JS_Call(jsCtx, func, getJSValue(), numArgs, args) };
+
+    if (JS_IsException(ret)) {
+        DBG("Exception thrown when evaluating onbindrow of <" << getTag().toString() << ">");
+        jsDumpError(jsCtx, ret);
+    }
+
+    JS_FreeValue(jsCtx, ret);
+
+    for (auto& arg : args)
+        JS_FreeValue(jsCtx, arg);
+
+    JS_FreeValue(jsCtx, func);
+}
+
+void VirtualList::resetItemAttributes(Row& row, std::vector<Identifier>&& newAttributes)
+{
+    for (const auto& name : row.itemAttributes) {
+        if (name == attr::index || std::find(newAttributes.begin(), newAttributes.end(), name) != newAttributes.end())
+            continue;
+
+        if (rowTemplate != nullptr && rowTemplate->hasAttribute(name.toString()))
+            row.element->setAttribute(name, rowTemplate->getStringAttribute(name.toString()));
+        else
+            row.element->removeAttribute(name);
+    }
+
+    row.itemAttributes = std::move(newAttributes);
+}
+
+//==============================================================================
+
+JSValue VirtualList::js_refresh(JSContext*, JSValueConst self, int, JSValueConst*)
+{
+    if (auto list{ Context::getJSNativeObject<VirtualList>(self) })
+        list->refresh();
+
+    return JS_UNDEFINED;
+}
+
+JSValue VirtualList::js_scrollToRow(JSContext* ctx, JSValueConst self, int argc, JSValueConst* arg)
+{
+    if (argc != 1)
+        return JS_ThrowSyntaxError(ctx, "scrollToRow expects a single argument - row index");
+
+    if (auto list{ Context::getJSNativeObject<VirtualList>(self) }) {
+        int index{};
+        JS_ToInt32(ctx, &index, arg[0]);
+        list->scrollToRow(index);
+    }
+
+    return JS_UNDEFINED;
+}
+
+} // namespace vitro
@@ -0,0 +1,165 @@
+namespace vitro {
+
+/** Virtualized list of rows.
+
+    This element displays a vertically scrollable list of equally sized rows.
+    Only the rows intersecting the visible area (plus an overscan margin)
+    are instantiated. The row elements are recycled as the list gets scrolled,
+    so that the scrolling cost does not depend on the total number of rows.
+
+    Rows are created from a template, which is the first child of
+    the <VirtualList> in XML:
+
+    <VirtualList count="50000">
+        <Label class="row" />
+    </VirtualList>
+
+    The rows data can be provided by either
+    - a C++ model (@see setModel);
+    - an array of items assigned to the items attribute. If an item is an object,
+      its properties will be assigned as the row attributes, otherwise the
+      item will be assigned to the row's text attribute;
+    - an onbindrow callback, which gets called as onbindrow(row, index, item).
+      A script assigned to onbindrow receives the { row, index, item }
+      object as its event.
+
+    When a row gets recycled, the attributes assigned from its previous item
+    are restored to the row template values, or removed.
+
+    Attributes:
+        count
+        items
+        overscan
+        onbindrow
+
+    Style properties:
+        row-height
+        thumb-color
+        scrollbar-thickness
+*/
+class VirtualList : public vitro::ComponentElement,
+                    public juce::Viewport
+{
+public:
+
+    /** Native data source for the list rows. */
+    class Model
+    {
+    public:
+        virtual ~Model() = default;
+
+        /** Returns the total number of rows in the list. */
+        virtual int getNumRows() = 0;
+
+        /** Populate the row element with the data at the given index. */
+        virtual void bindRow(const Element::Ptr& row, int index) = 0;
+    };
+
+    const static juce::Identifier tag;  // <VirtualList>
+
+    static JSClassID jsClassID;
+
+    VirtualList(Context& ctx);
+
+    JSClassID getJSClassID() const override { return vitro::VirtualList::jsClassID; }
+
+    juce::Component* getComponent() override { return this; }
+
+    juce::Component* getContainerComponent() override { return &container; }
+
+    bool hasInnerXml() const override { return true; }
+
+    void forwardXmlElement(const juce::XmlElement& xml) override;
+
+    /** Assign the native rows model.
+
+        The model takes precedence over the items and count attributes.
+        @note The list does not take ownership of the model.
+    */
+    void setModel(Model* model);
+
+    /** Returns total number of rows. */
+    int getNumRows() const;
+
+    /** Rebind all the currently instantiated rows.
+
+        This should be called when the underlying data changes.
+    */
+    void refresh();
+
+    /** Scroll the list to make the row at given index visible. */
+    void scrollToRow(int index);
+
+    // juce::Viewport
+    void resized() override;
+    void visibleAreaChanged(const juce::Rectangle<int>& newVisibleArea) override;
+
+    static void registerJSPrototype(JSContext* ctx, JSValue prototype);
+
+protected:
+
+    // vitro::Element
+    void update() override;
+    void cloneFrom(const Element& other) override;
+
+private:
+
+    struct Row final
+    {
+        LayoutElement::Ptr element{};
+        int index{ -1 };
+
+        // Attributes assigned from the bound item.
+        std::vector<juce::Identifier> itemAttributes{};
+    };
+
+    /** Rows container of the size of the entire list. */
+    class Container : public juce::Component
+    {
+    public:
+        Container(VirtualList& owner);
+
+        // juce::Component
+        void paint(juce::Graphics& g) override;
+
+    private:
+        VirtualList& list;
+    };
+
+    float getRowHeight() const;
+
+    // Instantiate, position and bind the rows for the visible area.
+    void updateVisibleRows();
+
+    // Remove all the instantiated rows.
+    void removeAllRows();
+
+    void bindRow(Row& row);
+
+    // Restore the attributes of the previously bound item that are not
+    // among the new ones to the row template values.
+    void resetItemAttributes(Row& row, std::vector<juce::Identifier>&& newAttributes);
+
+    // JavaScript methods and properties
+    static JSValue js_refresh(JSContext* ctx, JSValueConst self, int argc, JSValueConst* arg);
+    static JSValue js_scrollToRow(JSContext* ctx, JSValueConst self, int argc, JSValueConst* arg);
+
+    Container container;
+
+    std::unique_ptr<juce::XmlElement> rowTemplate{};
+
+    Model* model{ nullptr };
+
+    // Recycled rows. A row displaying the item at index i
+    // occupies the slot i % rows.size().
+    std::vector<Row> rows{};
+
+    int numRows{ 0 };
+    int overscan{ 2 };
+
+    bool updatingRows{ false };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(VirtualList)
+};
+
+} // namespace vitro